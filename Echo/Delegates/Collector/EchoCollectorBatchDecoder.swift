@@ -0,0 +1,37 @@
+//
+//  EchoCollectorBatchDecoder.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Expands a collector batch written by `EchoCollectorBatcher` back into complete events, with the
+ persistent labels of the snapshot each event refers to merged under its own labels.
+ */
+internal enum EchoCollectorBatchDecoder {
+
+    static func events(in batch: [String: Any]) -> [[String: Any]] {
+        let snapshots = batch["snapshots"] as? [String: [String: String]] ?? [:]
+        let events = batch["events"] as? [[String: Any]] ?? []
+
+        return events.map { event in
+            var event = event
+            var labels = [String: String]()
+
+            if let version = event.removeValue(forKey: "snapshot") {
+                labels = snapshots["\(version)"] ?? [:]
+            }
+
+            if let eventLabels = event["labels"] as? [String: String] {
+                labels.merge(eventLabels) { _, new in new }
+            }
+
+            event["labels"] = labels
+            return event
+        }
+    }
+
+}
@@ -0,0 +1,385 @@
+//
+//  EchoCollectorBatcher.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Groups serialised events into batches and uploads them to an Echo collector one at a time.
+
+ A batch is sealed once it holds `maxEvents` events or `maxBytes` bytes, or `maxAge` seconds after its
+ first event. Sealed batches are sent strictly in order with a single request in flight, so the
+ collector sees them in the order the events happened. A failed batch stays at the head of the queue
+ and is retried with exponential backoff; batches the collector rejects outright (4xx other than
+ 408 and 429) are dropped so that they cannot block the queue.
+
+ Each batch body is `{"session":"<id>","batch":<sequence>,"snapshots":{"<version>":{...}},"events":[...]}`.
+ Sequences restart with each batcher, that is each launch, under a new session ID, so the collector can
+ detect gaps and replays per session. Events enqueued with a `PersistentLabelSnapshot` carry only its
+ version in `"snapshot"`, and each version they refer to is included once in the batch;
+ `EchoCollectorBatchDecoder` expands them back into full events.
+ With `compressBatches` set, bodies are deflated with `EchoCompressionDictionary.collector` and sent with
+ `Content-Encoding: deflate` and the dictionary version in `X-Echo-Dictionary`.
+
+ With `holdUntilFlushed` set, sealed batches wait for the next `flush` rather than being sent straight
+ away, so that an `EchoFlushScheduler` can group uploads into its flush windows. It can be changed later
+ with `holdUntilFlushed(_:)`.
+ */
+internal class EchoCollectorBatcher: EchoFlushTarget {
+
+    struct Configuration {
+        var maxEvents = 50
+        var maxBytes = 64 * 1024
+        var maxAge: TimeInterval = 30
+        var retryBaseDelay: TimeInterval = 2
+        var maxRetryDelay: TimeInterval = 300
+        /// Sealed batches held while the collector is unreachable, after which the oldest are dropped
+        var maxQueuedBatches = 100
+        /// Total size of sealed batches held, after which the oldest are dropped
+        var maxQueuedBytes = Int.max
+        var headers = ["Content-Type": "application/json"]
+        var compressBatches = false
+        var holdUntilFlushed = false
+
+        init() {
+        }
+    }
+
+    struct Statistics {
+        var events = 0
+        var requests = 0
+        var bytes = 0
+        /// Body bytes before compression
+        var uncompressedBytes = 0
+        var failedRequests = 0
+        var droppedBatches = 0
+        /// Bytes of batches the collector accepted
+        var acknowledgedBytes = 0
+    }
+
+    private struct Batch {
+        let sequence: UInt64
+        let body: Data
+        let compressed: Bool
+    }
+
+    private let url: URL
+    private let client: HttpPostClientProtocol
+    private var configuration: Configuration
+    /// Sent with every batch, telling this launch's sequence numbers apart from those of earlier launches
+    let session: String
+    private let queue: DispatchQueue
+
+    private var pending = [Data]()
+    private var pendingBytes = 0
+    private var pendingGeneration = 0
+    private var pendingSnapshotVersions = [UInt32]()
+    private var snapshots = [UInt32: Data]()
+    // Caller side: the last snapshot serialised, so unchanged labels are not serialised again per event
+    private var lastSnapshotVersion: UInt32 = 0
+    private var outbox = [Batch]()
+    private var nextSequence: UInt64 = 1
+    private var inFlight = false
+    private var waitingToRetry = false
+    private var retryGeneration = 0
+    private var retryCount = 0
+    private var draining = false
+    private var flushWaiters = [(completion: (EchoFlushOutcome) -> Void, acknowledgedBytes: Int)]()
+    private var stats = Statistics()
+
+    init(url: URL, client: HttpPostClientProtocol, configuration: Configuration = Configuration(),
+         session: String = UUID().uuidString, queue: DispatchQueue = DispatchQueue(label: "uk.co.bbc.echo.collector")) {
+        self.url = url
+        self.client = client
+        self.configuration = configuration
+        self.session = session
+        self.queue = queue
+    }
+
+    var statistics: Statistics {
+        return queue.sync { stats }
+    }
+
+    func enqueue(_ event: [String: Any], snapshot: PersistentLabelSnapshot? = nil) {
+        var event = event
+        var snapshotVersion: UInt32?
+        var snapshotData: Data?
+
+        if let snapshot = snapshot, snapshot.version > 0 {
+            snapshotVersion = snapshot.version
+            event["snapshot"] = snapshot.version
+
+            if snapshot.version != lastSnapshotVersion {
+                snapshotData = try? JSONSerialization.data(withJSONObject: snapshot.labels, options: [])
+                lastSnapshotVersion = snapshot.version
+            }
+        }
+
+        guard JSONSerialization.isValidJSONObject(event),
+              let data = try? JSONSerialization.data(withJSONObject: event, options: []) else {
+            EchoDebug.log(level: .error, message: "Unable to serialise event for the collector")
+            return
+        }
+
+        queue.async {
+            if let snapshotVersion = snapshotVersion {
+                if let snapshotData = snapshotData {
+                    self.snapshots[snapshotVersion] = snapshotData
+                }
+                if self.pendingSnapshotVersions.last != snapshotVersion {
+                    self.pendingSnapshotVersions.append(snapshotVersion)
+                    self.pendingBytes += self.snapshots[snapshotVersion]?.count ?? 0
+                }
+            }
+
+            self.pending.append(data)
+            self.pendingBytes += data.count
+            self.stats.events += 1
+
+            if self.pending.count >= self.configuration.maxEvents || self.pendingBytes >= self.configuration.maxBytes {
+                self.sealPending()
+            } else if self.pending.count == 1 {
+                self.scheduleAgeFlush()
+            }
+        }
+    }
+
+    /**
+     Seals whatever is pending and starts sending, without waiting for the size or age limits.
+     */
+    func flush() {
+        queue.async {
+            self.startDraining()
+        }
+    }
+
+    /**
+     As `flush()`, calling `completion` once everything sealed has been accepted or a send has failed.
+     */
+    func flush(completion: @escaping (EchoFlushOutcome) -> Void) {
+        queue.async {
+            self.flushWaiters.append((completion, self.stats.acknowledgedBytes))
+            self.startDraining()
+
+            if self.outbox.isEmpty && !self.inFlight {
+                self.completeFlushes(failed: false)
+            }
+        }
+    }
+
+    /**
+     Drops everything pending and sealed without sending it, e.g. when the user's data is reset. A batch
+     already in flight is not retried if it fails.
+     */
+    func clear() {
+        // Snapshots are dropped too, so the next event must serialise its labels again
+        lastSnapshotVersion = 0
+
+        queue.async {
+            self.pending.removeAll()
+            self.pendingBytes = 0
+            self.pendingGeneration += 1
+            self.pendingSnapshotVersions.removeAll()
+            self.snapshots.removeAll()
+            self.outbox.removeAll()
+            self.retryCount = 0
+
+            if self.waitingToRetry {
+                self.waitingToRetry = false
+                self.retryGeneration += 1
+            }
+            if !self.inFlight {
+                self.completeFlushes(failed: false)
+            }
+        }
+    }
+
+    /**
+     Blocks until everything enqueued so far has been sealed and handed to the client. Test support only.
+     */
+    /// Sets `holdUntilFlushed`, sending anything sealed straight away once batches are no longer held
+    func holdUntilFlushed(_ hold: Bool) {
+        queue.async {
+            self.configuration.holdUntilFlushed = hold
+            self.sendNext()
+        }
+    }
+
+    func waitUntilIdle() {
+        queue.sync {}
+    }
+
+    // MARK: - Queue confined
+
+    private func startDraining() {
+        draining = true
+
+        // Flushing is an explicit request to send now, so skip any backoff still to run
+        if waitingToRetry {
+            waitingToRetry = false
+            retryGeneration += 1
+        }
+
+        sealPending()
+    }
+
+    private func completeFlushes(failed: Bool) {
+        draining = false
+
+        let waiters = flushWaiters
+        flushWaiters.removeAll()
+        for waiter in waiters {
+            waiter.completion(failed ? .failed : .sent(bytes: stats.acknowledgedBytes - waiter.acknowledgedBytes))
+        }
+    }
+
+    private func scheduleAgeFlush() {
+        let generation = pendingGeneration
+        queue.asyncAfter(deadline: .now() + configuration.maxAge) {
+            if self.pendingGeneration == generation {
+                self.sealPending()
+            }
+        }
+    }
+
+    private func sealPending() {
+        guard !pending.isEmpty else {
+            sendNext()
+            return
+        }
+
+        var body = Data("{\"session\":\"\(session)\",\"batch\":\(nextSequence),".utf8)
+
+        if !pendingSnapshotVersions.isEmpty {
+            body.append(contentsOf: Array("\"snapshots\":{".utf8))
+            for (index, version) in Set(pendingSnapshotVersions).sorted().enumerated() {
+                if index > 0 {
+                    body.append(UInt8(ascii: ","))
+                }
+                body.append(contentsOf: Array("\"\(version)\":".utf8))
+                body.append(snapshots[version] ?? Data("{}".utf8))
+            }
+            body.append(contentsOf: Array("},".utf8))
+
+            // Only the latest snapshot can be referred to by events still to come
+            let latest = pendingSnapshotVersions.last!
+            snapshots = snapshots.filter { $0.key == latest }
+            pendingSnapshotVersions.removeAll()
+        }
+
+        body.append(contentsOf: Array("\"events\":[".utf8))
+        for (index, event) in pending.enumerated() {
+            if index > 0 {
+                body.append(UInt8(ascii: ","))
+            }
+            body.append(event)
+        }
+        body.append(contentsOf: Array("]}".utf8))
+        stats.uncompressedBytes += body.count
+
+        if configuration.compressBatches, let compressed = EchoCompressionDictionary.collector.compress(body) {
+            outbox.append(Batch(sequence: nextSequence, body: compressed, compressed: true))
+        } else {
+            outbox.append(Batch(sequence: nextSequence, body: body, compressed: false))
+        }
+        nextSequence += 1
+        pending.removeAll(keepingCapacity: true)
+        pendingBytes = 0
+        pendingGeneration += 1
+
+        // The batch in flight is never dropped, nor the one just sealed
+        let oldest = inFlight ? 1 : 0
+        while outbox.count - oldest > 1 && (outbox.count > configuration.maxQueuedBatches
+                                             || outbox.reduce(0, { $0 + $1.body.count }) > configuration.maxQueuedBytes) {
+            outbox.remove(at: oldest)
+            stats.droppedBatches += 1
+            EchoDebug.log(level: .warn, message: "Collector queue full, dropping oldest batch")
+        }
+
+        sendNext()
+    }
+
+    private func sendNext() {
+        guard !inFlight, !waitingToRetry, draining || !configuration.holdUntilFlushed, let batch = outbox.first else {
+            return
+        }
+
+        inFlight = true
+        stats.requests += 1
+        stats.bytes += batch.body.count
+
+        var headers = configuration.headers
+        if batch.compressed {
+            headers["Content-Encoding"] = "deflate"
+            headers[EchoCompressionDictionary.headerField] = String(EchoCompressionDictionary.collector.version)
+        }
+
+        client.post(batch.body, to: url, headers: headers) { result in
+            self.queue.async {
+                self.complete(batch, result: result)
+            }
+        }
+    }
+
+    private func complete(_ batch: Batch, result: HttpPostResult) {
+        inFlight = false
+
+        // Cleared while in flight, so nothing is left to retry
+        guard outbox.contains(where: { $0.sequence == batch.sequence }) else {
+            sendNextOrCompleteFlushes()
+            return
+        }
+
+        switch result {
+        case .success:
+            retryCount = 0
+            stats.acknowledgedBytes += batch.body.count
+            removeFromOutbox(batch)
+            sendNextOrCompleteFlushes()
+        case .failure(let statusCode):
+            stats.failedRequests += 1
+
+            if let statusCode = statusCode, (400..<500).contains(statusCode), statusCode != 408, statusCode != 429 {
+                EchoDebug.log(level: .error, message: "Collector rejected batch \(batch.sequence) with status \(statusCode)")
+                retryCount = 0
+                removeFromOutbox(batch)
+                stats.droppedBatches += 1
+                sendNextOrCompleteFlushes()
+                return
+            }
+
+            let delay = min(configuration.maxRetryDelay, configuration.retryBaseDelay * pow(2, Double(retryCount)))
+            retryCount += 1
+            EchoDebug.log(level: .info, message: "Collector upload failed, retrying batch \(batch.sequence) in \(delay)s")
+
+            completeFlushes(failed: true)
+
+            waitingToRetry = true
+            let generation = retryGeneration
+            queue.asyncAfter(deadline: .now() + delay) {
+                if self.retryGeneration == generation {
+                    self.waitingToRetry = false
+                    self.sendNext()
+                }
+            }
+        }
+    }
+
+    private func sendNextOrCompleteFlushes() {
+        if outbox.isEmpty {
+            completeFlushes(failed: false)
+        } else {
+            sendNext()
+        }
+    }
+
+    private func removeFromOutbox(_ batch: Batch) {
+        if let index = outbox.firstIndex(where: { $0.sequence == batch.sequence }) {
+            outbox.remove(at: index)
+        }
+    }
+
+}
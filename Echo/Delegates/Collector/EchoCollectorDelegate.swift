@@ -0,0 +1,299 @@
+//
+//  EchoCollectorDelegate.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Echo-native delegate which sends events to an Echo collector in batches, rather than one request per
+ hit as the vendor SDKs do. Persistent and player labels are sent once per batch as a versioned
+ snapshot; each event carries the snapshot version plus its own event and media labels.
+ In the `.all` cache mode batches are held until the cache is flushed, as the vendor SDKs hold their hits;
+ in `.offline` they are sent as they fill.
+ It keeps its own state and does no UI work, so it can run off the main thread behind an `IsolatedDelegate`.
+ */
+internal class EchoCollectorDelegate: NSObject, EchoIsolatableDelegate, EchoFlushTarget {
+
+    private let batcher: EchoCollectorBatcher
+    private let appName: String
+
+    private var enabled = true
+    private var started = false
+    private var deviceID: String?
+    private var counterName: String?
+    private var cacheMode: EchoCacheMode
+    /// Whether batches are held until flushed whatever the cache mode, e.g. for an `EchoFlushScheduler`
+    private let holdUntilFlushed: Bool
+    private let persistentLabels = PersistentLabelSnapshot()
+    private var mediaLabels = [String: String]()
+
+    static let cacheQuotaName = "collector"
+
+    init(appName: String, collectorURL: URL, httpClient: HttpPostClientProtocol = HttpPostClient(),
+         configuration: EchoCollectorBatcher.Configuration = EchoCollectorBatcher.Configuration(),
+         cachePolicy: EchoCachePolicy? = nil, cacheMode: EchoCacheMode = .offline) {
+        var configuration = configuration
+        if let quota = cachePolicy?.quota(for: EchoCollectorDelegate.cacheQuotaName) {
+            configuration.maxQueuedBytes = quota
+        }
+        holdUntilFlushed = configuration.holdUntilFlushed
+        configuration.holdUntilFlushed = holdUntilFlushed || cacheMode == .all
+
+        self.appName = appName
+        self.cacheMode = cacheMode
+        self.batcher = EchoCollectorBatcher(url: collectorURL, client: httpClient, configuration: configuration)
+        super.init()
+    }
+
+    var statistics: EchoCollectorBatcher.Statistics {
+        return batcher.statistics
+    }
+
+    internal func waitUntilIdle() {
+        batcher.waitUntilIdle()
+    }
+
+    // MARK: - Events
+
+    private func send(_ type: String, name: String? = nil, actionType: String? = nil, position: UInt64? = nil,
+                      rate: UInt64? = nil, eventLabels: [String: String]?, includeMedia: Bool = false) {
+        guard enabled && started else {
+            return
+        }
+
+        var event: [String: Any] = ["event": type,
+                                    "ts": UInt64(Date().timeIntervalSince1970 * 1000),
+                                    "app": appName]
+
+        event["counter"] = counterName
+        event["device"] = deviceID
+        event["name"] = name
+        event["action_type"] = actionType
+        event["position"] = position
+        event["rate"] = rate
+
+        var labels = includeMedia ? mediaLabels : [String: String]()
+        if let eventLabels = eventLabels {
+            labels.merge(eventLabels) { _, new in new }
+        }
+        event["labels"] = labels
+
+        batcher.enqueue(event, snapshot: persistentLabels)
+    }
+
+    func viewEvent(counterName: String, eventLabels: [String: String]?) {
+        self.counterName = counterName
+        send("view", eventLabels: eventLabels)
+    }
+
+    func userActionEvent(actionType: String, actionName: String, eventLabels: [String: String]?) {
+        send("user_action", name: actionName, actionType: actionType, eventLabels: eventLabels)
+    }
+
+    func errorEvent(_ error: String, eventLabels: [String: String]?) {
+        send("error", name: error, eventLabels: eventLabels)
+    }
+
+    func avPlayEvent(at position: UInt64, eventLabels: [String: String]?) {
+        send("av_play", position: position, eventLabels: eventLabels, includeMedia: true)
+    }
+
+    func avPauseEvent(at position: UInt64, eventLabels: [String: String]?) {
+        send("av_pause", position: position, eventLabels: eventLabels, includeMedia: true)
+    }
+
+    func avBufferEvent(at position: UInt64, eventLabels: [String: String]?) {
+        send("av_buffer", position: position, eventLabels: eventLabels, includeMedia: true)
+    }
+
+    func avEndEvent(at position: UInt64, eventLabels: [String: String]?) {
+        send("av_end", position: position, eventLabels: eventLabels, includeMedia: true)
+    }
+
+    func avRewindEvent(at position: UInt64, rate: UInt64, eventLabels: [String: String]?) {
+        send("av_rewind", position: position, rate: rate, eventLabels: eventLabels, includeMedia: true)
+    }
+
+    func avFastForwardEvent(at position: UInt64, rate: UInt64, eventLabels: [String: String]?) {
+        send("av_fast_forward", position: position, rate: rate, eventLabels: eventLabels, includeMedia: true)
+    }
+
+    func avSeekEvent(at position: UInt64, eventLabels: [String: String]?) {
+        send("av_seek", position: position, eventLabels: eventLabels, includeMedia: true)
+    }
+
+    func avUserActionEvent(actionType: String, actionName: String, position: UInt64, eventLabels: [String: String]?) {
+        send("av_user_action", name: actionName, actionType: actionType, position: position,
+             eventLabels: eventLabels, includeMedia: true)
+    }
+
+    // MARK: - Labels
+
+    func addLabels(_ labels: [String: String]) {
+        persistentLabels.add(labels)
+    }
+
+    func addLabel(_ key: String, value: String) {
+        persistentLabels.add([key: value])
+    }
+
+    func removeLabels(_ labels: [String]) {
+        persistentLabels.remove(labels)
+    }
+
+    func removeLabel(_ key: String) {
+        persistentLabels.remove([key])
+    }
+
+    func addManagedLabel(_ label: ManagedLabel, value: String) {
+        persistentLabels.add([label.name(): value])
+    }
+
+    func setCounterName(_ counterName: String) {
+        self.counterName = counterName
+    }
+
+    func setContentLanguage(_ language: String) {
+        persistentLabels.add(["content_language": language])
+    }
+
+    func setTraceID(_ trace: String) {
+        persistentLabels.add(["trace": trace])
+    }
+
+    func setDestination(_ site: Destination) {
+        persistentLabels.add(["destination": String(describing: site)])
+    }
+
+    func setProducer(_ site: Producer) {
+        persistentLabels.add(["producer": String(describing: site)])
+    }
+
+    func updateDeviceID(_ deviceId: String) {
+        deviceID = deviceId
+    }
+
+    func getDeviceID() -> String? {
+        return deviceID
+    }
+
+    func setBBCUser(_ user: BBCUser) {
+    }
+
+    func updateBBCUserLabels(_ user: BBCUser) {
+    }
+
+    func userStateChange() {
+    }
+
+    // MARK: - Player
+
+    func setPlayerName(_ name: String) {
+        persistentLabels.add(["player_name": name])
+    }
+
+    func setPlayerVersion(_ version: String) {
+        persistentLabels.add(["player_version": version])
+    }
+
+    func setPlayerIsPopped(_ popped: Bool) {
+        persistentLabels.add(["player_popped": popped ? "1" : "0"])
+    }
+
+    func setPlayerWindowState(_ state: WindowState) {
+        persistentLabels.add(["player_window_state": String(describing: state)])
+    }
+
+    func setPlayerVolume(_ volume: Int) {
+        persistentLabels.add(["player_volume": String(volume)])
+    }
+
+    func setPlayerIsSubtitled(_ subtitled: Bool) {
+        persistentLabels.add(["player_subtitled": subtitled ? "1" : "0"])
+    }
+
+    // MARK: - Media
+
+    func setMedia(_ media: Media) {
+        mediaLabels.removeAll()
+        mediaLabels["media_version_id"] = media.versionID
+        mediaLabels["media_service_id"] = media.serviceID
+        mediaLabels["media_is_live"] = media.isLive ? "1" : "0"
+        if media.length > 0 {
+            mediaLabels["media_length"] = String(media.length)
+        }
+    }
+
+    func clearMedia() {
+        mediaLabels.removeAll()
+    }
+
+    func setMediaLength(_ length: UInt64) {
+        mediaLabels["media_length"] = String(length)
+    }
+
+    func setMediaBitrate(_ bitrate: UInt64) {
+    }
+
+    func setMediaCodec(_ codec: String) {
+    }
+
+    func setMediaCDN(_ cdn: String) {
+    }
+
+    func liveMediaUpdate(_ newMedia: Media, newPosition: UInt64, oldPosition: UInt64) {
+        setMedia(newMedia)
+    }
+
+    func liveEnrichmentFailed() {
+    }
+
+    func setBroker(broker: Broker) {
+    }
+
+    // MARK: - Lifecycle
+
+    func start() {
+        started = true
+    }
+
+    func enable() {
+        enabled = true
+    }
+
+    func disable() {
+        enabled = false
+    }
+
+    func appForegrounded() {
+    }
+
+    func appBackgrounded() {
+        batcher.flush()
+    }
+
+    func setCacheMode(_ cacheMode: EchoCacheMode) {
+        self.cacheMode = cacheMode
+        batcher.holdUntilFlushed(holdUntilFlushed || cacheMode == .all)
+    }
+
+    func getCacheMode() -> EchoCacheMode {
+        return cacheMode
+    }
+
+    func flushCache() {
+        batcher.flush()
+    }
+
+    func clearCache() {
+        batcher.clear()
+    }
+
+    func flush(completion: @escaping (EchoFlushOutcome) -> Void) {
+        batcher.flush(completion: completion)
+    }
+
+}
@@ -0,0 +1,283 @@
+//
+//  DeferredDelegates.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Stands in for the delegates until they are needed, so that the vendor SDKs are not set up during
+ app launch. Calls which only configure the delegates are recorded; the first event, or a call whose
+ result is needed, constructs the delegates with `factory` and replays everything recorded, in order,
+ before it is forwarded. `construct()` may also be called directly, e.g. after a post-launch delay.
+
+ Like `EchoClient`, this expects to be called from the main thread.
+ */
+internal final class DeferredDelegates: NSObject, EchoDelegate {
+
+    private let factory: () -> [EchoDelegate]
+    private var recorded = [(EchoDelegate) -> Void]()
+    private var constructed: [EchoDelegate]?
+
+    /// Called once the delegates have been constructed, so the owner can stop going through this stand-in
+    var onConstructed: (([EchoDelegate]) -> Void)?
+
+    init(factory: @escaping () -> [EchoDelegate]) {
+        self.factory = factory
+        super.init()
+    }
+
+    var isConstructed: Bool {
+        return constructed != nil
+    }
+
+    var recordedCallCount: Int {
+        return recorded.count
+    }
+
+    @discardableResult
+    func construct() -> [EchoDelegate] {
+        if let constructed = constructed {
+            return constructed
+        }
+
+        let delegates = factory()
+        for call in recorded {
+            delegates.forEach(call)
+        }
+        recorded.removeAll()
+        constructed = delegates
+
+        EchoDebug.log(level: .info, message: "Delegates constructed")
+        onConstructed?(delegates)
+        return delegates
+    }
+
+    private func record(_ call: @escaping (EchoDelegate) -> Void) {
+        if let constructed = constructed {
+            constructed.forEach(call)
+        } else {
+            recorded.append(call)
+        }
+    }
+
+    private func dispatch(_ call: (EchoDelegate) -> Void) {
+        construct().forEach(call)
+    }
+
+    // MARK: - Events
+
+    func viewEvent(counterName: String, eventLabels: [String: String]?) {
+        dispatch { $0.viewEvent(counterName: counterName, eventLabels: eventLabels) }
+    }
+
+    func userActionEvent(actionType: String, actionName: String, eventLabels: [String: String]?) {
+        dispatch { $0.userActionEvent(actionType: actionType, actionName: actionName, eventLabels: eventLabels) }
+    }
+
+    func errorEvent(_ error: String, eventLabels: [String: String]?) {
+        dispatch { $0.errorEvent(error, eventLabels: eventLabels) }
+    }
+
+    func avPlayEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avPlayEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avPauseEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avPauseEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avBufferEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avBufferEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avEndEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avEndEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avRewindEvent(at position: UInt64, rate: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avRewindEvent(at: position, rate: rate, eventLabels: eventLabels) }
+    }
+
+    func avFastForwardEvent(at position: UInt64, rate: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avFastForwardEvent(at: position, rate: rate, eventLabels: eventLabels) }
+    }
+
+    func avSeekEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avSeekEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avUserActionEvent(actionType: String, actionName: String, position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avUserActionEvent(actionType: actionType, actionName: actionName, position: position,
+                                        eventLabels: eventLabels) }
+    }
+
+    // MARK: - Results
+
+    func getDeviceID() -> String? {
+        return construct().lazy.compactMap { $0.getDeviceID() }.first
+    }
+
+    func getCacheMode() -> EchoCacheMode {
+        return construct().first?.getCacheMode() ?? .offline
+    }
+
+    // MARK: - Labels
+
+    func addLabels(_ labels: [String: String]) {
+        record { $0.addLabels(labels) }
+    }
+
+    func addLabel(_ key: String, value: String) {
+        record { $0.addLabel(key, value: value) }
+    }
+
+    func removeLabels(_ labels: [String]) {
+        record { $0.removeLabels(labels) }
+    }
+
+    func removeLabel(_ key: String) {
+        record { $0.removeLabel(key) }
+    }
+
+    func addManagedLabel(_ label: ManagedLabel, value: String) {
+        record { $0.addManagedLabel(label, value: value) }
+    }
+
+    func setCounterName(_ counterName: String) {
+        record { $0.setCounterName(counterName) }
+    }
+
+    func setContentLanguage(_ language: String) {
+        record { $0.setContentLanguage(language) }
+    }
+
+    func setTraceID(_ trace: String) {
+        record { $0.setTraceID(trace) }
+    }
+
+    func setDestination(_ site: Destination) {
+        record { $0.setDestination(site) }
+    }
+
+    func setProducer(_ site: Producer) {
+        record { $0.setProducer(site) }
+    }
+
+    func updateDeviceID(_ deviceId: String) {
+        record { $0.updateDeviceID(deviceId) }
+    }
+
+    func setBBCUser(_ user: BBCUser) {
+        record { $0.setBBCUser(user) }
+    }
+
+    func updateBBCUserLabels(_ user: BBCUser) {
+        record { $0.updateBBCUserLabels(user) }
+    }
+
+    func userStateChange() {
+        record { $0.userStateChange() }
+    }
+
+    // MARK: - Player
+
+    func setPlayerName(_ name: String) {
+        record { $0.setPlayerName(name) }
+    }
+
+    func setPlayerVersion(_ version: String) {
+        record { $0.setPlayerVersion(version) }
+    }
+
+    func setPlayerIsPopped(_ popped: Bool) {
+        record { $0.setPlayerIsPopped(popped) }
+    }
+
+    func setPlayerWindowState(_ state: WindowState) {
+        record { $0.setPlayerWindowState(state) }
+    }
+
+    func setPlayerVolume(_ volume: Int) {
+        record { $0.setPlayerVolume(volume) }
+    }
+
+    func setPlayerIsSubtitled(_ subtitled: Bool) {
+        record { $0.setPlayerIsSubtitled(subtitled) }
+    }
+
+    // MARK: - Media
+
+    func setMedia(_ media: Media) {
+        record { $0.setMedia(media) }
+    }
+
+    func clearMedia() {
+        record { $0.clearMedia() }
+    }
+
+    func setMediaLength(_ length: UInt64) {
+        record { $0.setMediaLength(length) }
+    }
+
+    func setMediaBitrate(_ bitrate: UInt64) {
+        record { $0.setMediaBitrate(bitrate) }
+    }
+
+    func setMediaCodec(_ codec: String) {
+        record { $0.setMediaCodec(codec) }
+    }
+
+    func setMediaCDN(_ cdn: String) {
+        record { $0.setMediaCDN(cdn) }
+    }
+
+    func liveMediaUpdate(_ newMedia: Media, newPosition: UInt64, oldPosition: UInt64) {
+        record { $0.liveMediaUpdate(newMedia, newPosition: newPosition, oldPosition: oldPosition) }
+    }
+
+    func liveEnrichmentFailed() {
+        record { $0.liveEnrichmentFailed() }
+    }
+
+    func setBroker(broker: Broker) {
+        record { $0.setBroker(broker: broker) }
+    }
+
+    // MARK: - Lifecycle
+
+    func start() {
+        record { $0.start() }
+    }
+
+    func enable() {
+        record { $0.enable() }
+    }
+
+    func disable() {
+        record { $0.disable() }
+    }
+
+    func appForegrounded() {
+        record { $0.appForegrounded() }
+    }
+
+    func appBackgrounded() {
+        record { $0.appBackgrounded() }
+    }
+
+    func setCacheMode(_ cacheMode: EchoCacheMode) {
+        record { $0.setCacheMode(cacheMode) }
+    }
+
+    func flushCache() {
+        record { $0.flushCache() }
+    }
+
+    func clearCache() {
+        record { $0.clearCache() }
+    }
+
+}
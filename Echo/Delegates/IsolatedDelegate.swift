@@ -0,0 +1,538 @@
+//
+//  IsolatedDelegate.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ A delegate which can be called off the main thread, one call at a time, and so can run behind an
+ `IsolatedDelegate`. The vendor SDKs expect to be called on the main thread, so their delegates do not
+ conform and stay there.
+ */
+internal protocol EchoIsolatableDelegate: EchoDelegate {
+}
+
+/**
+ Runs a delegate on its own serial queue, so that a delegate which stalls, e.g. on a blocking disk
+ write, holds up neither the other delegates nor the caller. Calls reach the delegate in the order
+ they were made. Calls whose result is needed wait for it, but for no longer than `resultTimeout`. On the
+ main thread they only wait for the results asked for in init, and only until `resultTimeout` after it;
+ from then on the result the delegate last gave is returned, and a fresh one asked for.
+
+ Each call is timed. One that goes over `budget` is logged and reported to `onSlowCall`. A call which is
+ still running is caught by a watchdog timer once it passes its budget, or by the next call made, and
+ reported once. With `shedAfter` set, a delegate whose calls go over budget that many times in a row is
+ shed: calls to it are dropped from then on.
+ */
+internal final class IsolatedDelegate: NSObject, EchoDelegate, EchoFlushTarget {
+
+    struct Configuration {
+        var budget: TimeInterval = 0.1
+        /// Calls over budget in a row after which the delegate is shed, nil to keep it however slow it is
+        var shedAfter: Int?
+        var resultTimeout: TimeInterval = 1
+
+        init() {
+        }
+    }
+
+    struct SlowCall {
+        let delegate: String
+        let call: String
+        /// How long the call took, or had been running for if it had not returned
+        let duration: TimeInterval
+        let returned: Bool
+        /// Whether this call caused the delegate to be shed
+        let shed: Bool
+    }
+
+    struct Statistics {
+        var calls = 0
+        var slowCalls = 0
+        var dropped = 0
+        var longestCall: TimeInterval = 0
+    }
+
+    /// Slow call reports and the watchdog run here, as the delegate's own queue may be the one stalled
+    private static let diagnosticsQueue = DispatchQueue(label: "uk.co.bbc.echo.delegate.diagnostics")
+
+    let wrapped: EchoDelegate
+    private let name: String
+    private let configuration: Configuration
+    private let clock: TimeProtocol
+    private let queue: DispatchQueue
+    private let watchdog: DispatchSourceTimer
+
+    /// Called on a diagnostics queue shared by every `IsolatedDelegate`, never the delegate's own
+    var onSlowCall: ((SlowCall) -> Void)?
+
+    private let lock = NSLock()
+    private var inFlight: (call: String, started: TimeInterval, reported: Bool)?
+    private var slowInARow = 0
+    private var shed = false
+    private var stats = Statistics()
+    // The results the delegate last gave, returned on the main thread rather than waiting
+    private var latestDeviceID: String?
+    private var latestCacheMode = EchoCacheMode.offline
+    // Left once the results asked for in init are in, which the main thread waits for until `primingDeadline`
+    private let priming = DispatchGroup()
+    private let primingDeadline: DispatchTime
+
+    init(_ wrapped: EchoIsolatableDelegate, configuration: Configuration = Configuration(), clock: TimeProtocol = SystemClock()) {
+        self.wrapped = wrapped
+        self.name = String(describing: type(of: wrapped))
+        self.configuration = configuration
+        self.clock = clock
+        self.queue = DispatchQueue(label: "uk.co.bbc.echo.delegate.\(name)")
+        self.watchdog = DispatchSource.makeTimerSource(queue: IsolatedDelegate.diagnosticsQueue)
+        self.primingDeadline = .now() + configuration.resultTimeout
+        super.init()
+
+        watchdog.setEventHandler { [weak self] in
+            self?.watchdogFired()
+        }
+        watchdog.schedule(deadline: .distantFuture)
+        watchdog.resume()
+
+        // So that the first results asked for on the main thread are the delegate's own
+        priming.enter()
+        dispatch("getDeviceID()") { _ = self.storeDeviceID($0.getDeviceID()) }
+        dispatch("getCacheMode()") {
+            _ = self.storeCacheMode($0.getCacheMode())
+            self.priming.leave()
+        }
+    }
+
+    deinit {
+        watchdog.cancel()
+    }
+
+    var isShed: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return shed
+    }
+
+    var statistics: Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return stats
+    }
+
+    /// Waits for the calls made so far and their slow call reports, for tests and for flushing before suspension
+    func drain() {
+        queue.sync {}
+        IsolatedDelegate.diagnosticsQueue.sync {}
+    }
+
+    /**
+     Reports the call in flight if it has gone over budget and has not been reported. Called by the
+     watchdog timer, and by tests after moving a `MockClock` on.
+     */
+    func checkStalled() {
+        lock.lock()
+        let stalled = checkInFlight()
+        lock.unlock()
+
+        if let stalled = stalled {
+            report(stalled)
+        }
+    }
+
+    /// Reports a stalled call, or waits out the rest of the budget of a call which is not over it yet
+    private func watchdogFired() {
+        lock.lock()
+        let stalled = checkInFlight()
+        var remaining: TimeInterval?
+        if let running = inFlight, !running.reported {
+            remaining = configuration.budget - (clock.currentTime() - running.started)
+        }
+        lock.unlock()
+
+        if let stalled = stalled {
+            report(stalled)
+        } else if let remaining = remaining {
+            watchdog.schedule(deadline: .now() + max(remaining, 0.01), leeway: .milliseconds(10))
+        }
+    }
+
+    /// Returns false if the call was dropped because the delegate has been shed
+    @discardableResult
+    private func dispatch(_ call: String = #function, _ work: @escaping (EchoDelegate) -> Void) -> Bool {
+        lock.lock()
+        if shed {
+            stats.dropped += 1
+            lock.unlock()
+            return false
+        }
+        let stalled = checkInFlight()
+        lock.unlock()
+
+        if let stalled = stalled {
+            report(stalled)
+        }
+
+        queue.async {
+            self.run(call, work)
+        }
+        return true
+    }
+
+    /**
+     Off the main thread, waits up to `resultTimeout` for `work`. On the main thread, or when the delegate
+     has been shed or does not answer in time, returns `latest`, the result the delegate last gave, once
+     the results asked for in init are in or `primingDeadline` has passed.
+     */
+    private func result<T>(_ call: String = #function, latest: () -> T, store: @escaping (T) -> T,
+                           _ work: @escaping (EchoDelegate) -> T) -> T {
+        var value: T?
+        let finished = DispatchSemaphore(value: 0)
+        let queued = dispatch(call) { delegate in
+            value = store(work(delegate))
+            finished.signal()
+        }
+
+        guard queued, !Thread.isMainThread else {
+            // A priming call which stalls is reported by the watchdog, so a timeout needs no logging here
+            _ = priming.wait(timeout: primingDeadline)
+            return latest()
+        }
+
+        guard finished.wait(timeout: .now() + configuration.resultTimeout) == .success, let answer = value else {
+            EchoDebug.log(level: .warn, message: "\(name) did not return \(call) within \(configuration.resultTimeout)s")
+            return latest()
+        }
+        return answer
+    }
+
+    private func storeDeviceID(_ deviceID: String?) -> String? {
+        lock.lock()
+        latestDeviceID = deviceID
+        lock.unlock()
+        return deviceID
+    }
+
+    private func lastDeviceID() -> String? {
+        lock.lock()
+        defer { lock.unlock() }
+        return latestDeviceID
+    }
+
+    private func storeCacheMode(_ cacheMode: EchoCacheMode) -> EchoCacheMode {
+        lock.lock()
+        latestCacheMode = cacheMode
+        lock.unlock()
+        return cacheMode
+    }
+
+    private func lastCacheMode() -> EchoCacheMode {
+        lock.lock()
+        defer { lock.unlock() }
+        return latestCacheMode
+    }
+
+    private func run(_ call: String, _ work: (EchoDelegate) -> Void) {
+        let started = clock.currentTime()
+        lock.lock()
+        inFlight = (call, started, false)
+        lock.unlock()
+        watchdog.schedule(deadline: .now() + configuration.budget, leeway: .milliseconds(10))
+
+        work(wrapped)
+
+        watchdog.schedule(deadline: .distantFuture)
+        let duration = clock.currentTime() - started
+        lock.lock()
+        let alreadyReported = inFlight?.reported ?? false
+        inFlight = nil
+        stats.calls += 1
+        stats.longestCall = max(stats.longestCall, duration)
+        var slow: SlowCall?
+        if duration > configuration.budget {
+            if !alreadyReported {
+                slow = recordSlowCall(call, duration: duration, returned: true)
+            }
+        } else {
+            slowInARow = 0
+        }
+        lock.unlock()
+
+        if let slow = slow {
+            report(slow)
+        }
+    }
+
+    /// A call still running past its budget, reported once. Expects `lock` to be held.
+    private func checkInFlight() -> SlowCall? {
+        guard let running = inFlight, !running.reported else {
+            return nil
+        }
+
+        let duration = clock.currentTime() - running.started
+        guard duration > configuration.budget else {
+            return nil
+        }
+
+        inFlight?.reported = true
+        return recordSlowCall(running.call, duration: duration, returned: false)
+    }
+
+    /// Expects `lock` to be held
+    private func recordSlowCall(_ call: String, duration: TimeInterval, returned: Bool) -> SlowCall {
+        stats.slowCalls += 1
+        slowInARow += 1
+
+        var shedNow = false
+        if let shedAfter = configuration.shedAfter, slowInARow >= shedAfter, !shed {
+            shed = true
+            shedNow = true
+        }
+
+        return SlowCall(delegate: name, call: call, duration: duration, returned: returned, shed: shedNow)
+    }
+
+    private func report(_ slow: SlowCall) {
+        let state = slow.returned ? "took" : "has been running for"
+        EchoDebug.log(level: .warn, message: "\(slow.delegate).\(slow.call) \(state) \(slow.duration)s, over its \(configuration.budget)s budget")
+        if slow.shed {
+            EchoDebug.log(level: .error, message: "\(slow.delegate) shed after \(configuration.shedAfter ?? 0) slow calls in a row")
+        }
+        if let onSlowCall = onSlowCall {
+            IsolatedDelegate.diagnosticsQueue.async {
+                onSlowCall(slow)
+            }
+        }
+    }
+
+    // MARK: - Events
+
+    func viewEvent(counterName: String, eventLabels: [String: String]?) {
+        dispatch { $0.viewEvent(counterName: counterName, eventLabels: eventLabels) }
+    }
+
+    func userActionEvent(actionType: String, actionName: String, eventLabels: [String: String]?) {
+        dispatch { $0.userActionEvent(actionType: actionType, actionName: actionName, eventLabels: eventLabels) }
+    }
+
+    func errorEvent(_ error: String, eventLabels: [String: String]?) {
+        dispatch { $0.errorEvent(error, eventLabels: eventLabels) }
+    }
+
+    func avPlayEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avPlayEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avPauseEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avPauseEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avBufferEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avBufferEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avEndEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avEndEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avRewindEvent(at position: UInt64, rate: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avRewindEvent(at: position, rate: rate, eventLabels: eventLabels) }
+    }
+
+    func avFastForwardEvent(at position: UInt64, rate: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avFastForwardEvent(at: position, rate: rate, eventLabels: eventLabels) }
+    }
+
+    func avSeekEvent(at position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avSeekEvent(at: position, eventLabels: eventLabels) }
+    }
+
+    func avUserActionEvent(actionType: String, actionName: String, position: UInt64, eventLabels: [String: String]?) {
+        dispatch { $0.avUserActionEvent(actionType: actionType, actionName: actionName, position: position,
+                                        eventLabels: eventLabels) }
+    }
+
+    // MARK: - Results
+
+    func getDeviceID() -> String? {
+        return result(latest: lastDeviceID, store: storeDeviceID) { $0.getDeviceID() }
+    }
+
+    func getCacheMode() -> EchoCacheMode {
+        return result(latest: lastCacheMode, store: storeCacheMode) { $0.getCacheMode() }
+    }
+
+    // MARK: - Labels
+
+    func addLabels(_ labels: [String: String]) {
+        dispatch { $0.addLabels(labels) }
+    }
+
+    func addLabel(_ key: String, value: String) {
+        dispatch { $0.addLabel(key, value: value) }
+    }
+
+    func removeLabels(_ labels: [String]) {
+        dispatch { $0.removeLabels(labels) }
+    }
+
+    func removeLabel(_ key: String) {
+        dispatch { $0.removeLabel(key) }
+    }
+
+    func addManagedLabel(_ label: ManagedLabel, value: String) {
+        dispatch { $0.addManagedLabel(label, value: value) }
+    }
+
+    func setCounterName(_ counterName: String) {
+        dispatch { $0.setCounterName(counterName) }
+    }
+
+    func setContentLanguage(_ language: String) {
+        dispatch { $0.setContentLanguage(language) }
+    }
+
+    func setTraceID(_ trace: String) {
+        dispatch { $0.setTraceID(trace) }
+    }
+
+    func setDestination(_ site: Destination) {
+        dispatch { $0.setDestination(site) }
+    }
+
+    func setProducer(_ site: Producer) {
+        dispatch { $0.setProducer(site) }
+    }
+
+    func updateDeviceID(_ deviceId: String) {
+        dispatch { $0.updateDeviceID(deviceId) }
+    }
+
+    func setBBCUser(_ user: BBCUser) {
+        dispatch { $0.setBBCUser(user) }
+    }
+
+    func updateBBCUserLabels(_ user: BBCUser) {
+        dispatch { $0.updateBBCUserLabels(user) }
+    }
+
+    func userStateChange() {
+        dispatch { $0.userStateChange() }
+    }
+
+    // MARK: - Player
+
+    func setPlayerName(_ name: String) {
+        dispatch { $0.setPlayerName(name) }
+    }
+
+    func setPlayerVersion(_ version: String) {
+        dispatch { $0.setPlayerVersion(version) }
+    }
+
+    func setPlayerIsPopped(_ popped: Bool) {
+        dispatch { $0.setPlayerIsPopped(popped) }
+    }
+
+    func setPlayerWindowState(_ state: WindowState) {
+        dispatch { $0.setPlayerWindowState(state) }
+    }
+
+    func setPlayerVolume(_ volume: Int) {
+        dispatch { $0.setPlayerVolume(volume) }
+    }
+
+    func setPlayerIsSubtitled(_ subtitled: Bool) {
+        dispatch { $0.setPlayerIsSubtitled(subtitled) }
+    }
+
+    // MARK: - Media
+
+    func setMedia(_ media: Media) {
+        dispatch { $0.setMedia(media) }
+    }
+
+    func clearMedia() {
+        dispatch { $0.clearMedia() }
+    }
+
+    func setMediaLength(_ length: UInt64) {
+        dispatch { $0.setMediaLength(length) }
+    }
+
+    func setMediaBitrate(_ bitrate: UInt64) {
+        dispatch { $0.setMediaBitrate(bitrate) }
+    }
+
+    func setMediaCodec(_ codec: String) {
+        dispatch { $0.setMediaCodec(codec) }
+    }
+
+    func setMediaCDN(_ cdn: String) {
+        dispatch { $0.setMediaCDN(cdn) }
+    }
+
+    func liveMediaUpdate(_ newMedia: Media, newPosition: UInt64, oldPosition: UInt64) {
+        dispatch { $0.liveMediaUpdate(newMedia, newPosition: newPosition, oldPosition: oldPosition) }
+    }
+
+    func liveEnrichmentFailed() {
+        dispatch { $0.liveEnrichmentFailed() }
+    }
+
+    func setBroker(broker: Broker) {
+        dispatch { $0.setBroker(broker: broker) }
+    }
+
+    // MARK: - Lifecycle
+
+    func start() {
+        dispatch { $0.start() }
+    }
+
+    func enable() {
+        dispatch { $0.enable() }
+    }
+
+    func disable() {
+        dispatch { $0.disable() }
+    }
+
+    func appForegrounded() {
+        dispatch { $0.appForegrounded() }
+    }
+
+    func appBackgrounded() {
+        dispatch { $0.appBackgrounded() }
+    }
+
+    func setCacheMode(_ cacheMode: EchoCacheMode) {
+        dispatch { $0.setCacheMode(cacheMode) }
+    }
+
+    func flushCache() {
+        dispatch { $0.flushCache() }
+    }
+
+    func clearCache() {
+        dispatch { $0.clearCache() }
+    }
+
+    /// Flushes behind the calls already made, so the flush covers every event handed over before it
+    func flush(completion: @escaping (EchoFlushOutcome) -> Void) {
+        let queued = dispatch { delegate in
+            if let target = delegate as? EchoFlushTarget {
+                target.flush(completion: completion)
+            } else {
+                delegate.flushCache()
+                completion(.handedOff)
+            }
+        }
+        if !queued {
+            completion(.failed)
+        }
+    }
+
+}
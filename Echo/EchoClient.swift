@@ -27,18 +27,40 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
     private var broker: Broker?
     private var labelCleanser: LabelCleanser
     private var userPromiseHelper: UserPromiseHelper!
+    /// Cookie clearing queued on main during initialisation, which initialisation does not wait for
+    private(set) internal var webviewStorageTask: EchoWebviewStorageTask?
 
     private var essUrl: String?
     private var essEnabled: Bool = false
     private var useHttps: Bool = false
 
     internal var delegates: [EchoDelegate]
+    /// Set while construction of the delegates is deferred, in which case it is the only entry in `delegates`
+    private var deferredDelegates: DeferredDelegates?
 
     internal var media: Media?
     private var mediaActive: Bool = false
 
     private var suppressingPlayEvent: Bool = false
     private var suppressedPlayEventLabels: [String: String]?
+    private let liveClock = LiveClockOffsetEstimator()
+    /// The MediaTimestamp label last pushed to the delegates, nil while none is set
+    private var mediaTimestampLabel: String?
+    private let liveEdgeLatency = LiveEdgeLatencyTracker()
+    /// Wall clock, read as the live edge when the player reports its timestamp
+    private let clock: TimeProtocol
+
+    /// Echo-owned record of dispatched events, written before each event reaches the delegates, when enabled in config
+    internal var eventLog: EchoEventLog? {
+        didSet {
+            replayThrough = eventLog?.lastSequence ?? 0
+        }
+    }
+    /// The last event logged by earlier sessions, the only ones replayed; this session's reach the delegates directly
+    private var replayThrough: UInt64 = 0
+    /// Automatic flushing of delegate caches, when enabled in config, see `startFlushScheduler`
+    private(set) internal var flushScheduler: EchoFlushScheduler?
+    private let persistentLabels = PersistentLabelSnapshot()
 
     private var cacheMode: EchoCacheMode
 
@@ -46,14 +68,33 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
     private var idv5Enabled: Bool = false
 
     var previousUser: BBCUser?
+    /// Echo's own record of the user and device state, kept alongside the `UserPromiseHelper`'s
+    internal let userStateStore: EchoUserStateStore
     private var bbcUserSetWhileDisabled: BBCUser?
-    private var userForTimer: BBCUser?
     private var resetDataOnUserStateChangeEnabled: Bool = false
-    private var timer: Timer!
+    /// What the delegates' user labels were last updated from, nil when they need a full update
+    private var userLabelsSent: EchoUserLabels?
+    /// Updates the delegates' user labels when the signed in user's token expires
+    internal lazy var tokenExpiry = EchoTokenExpiryScheduler { [weak self] user in
+        self?.expireToken(user)
+    }
+
+    /**
+     Set before creating a client to record how long each phase of its initialisation takes, see
+     `startupReport`.
+     */
+    @objc public static var startupProfilingEnabled = false
+    private let startupProfiler: EchoStartupProfiler
+    /// Timings for this client's initialisation, when `startupProfilingEnabled` was set
+    @objc public private(set) var startupReport: EchoStartupReport?
 
     /**
      Create an instance of Echo.
 
+     Set `EchoConfigKey.echoDelegateConstructionDelay` in `config` to construct the delegates after launch
+     rather than here, and `EchoConfigKey.echoDelegateIsolationEnabled` to run those which can be called off
+     the main thread each on its own queue.
+
      - parameters:
         - appName: The name of the containing app
         - appType: The type of the containing app
@@ -71,75 +112,169 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
                           brokerFactory: BrokerFactory(), bbcUser: bbcUser)
     }
 
+    /**
+     With `delegateConstructionDelay` set, or else `EchoConfigKey.echoDelegateConstructionDelay`, the delegates
+     and their SDKs are not constructed here but on the first event, or once the delay has passed, whichever
+     comes first. Calls made before then are replayed to them in order.
+
+     `webviewStorage` defaults to clearing cookies through the `UserPromiseHelper`.
+
+     With `delegateIsolation` set, or else `EchoConfigKey.echoDelegateIsolationEnabled`, each
+     `EchoIsolatableDelegate` runs on its own serial queue behind an `IsolatedDelegate`, so that a stalled
+     delegate does not hold up the others or the caller. The vendor SDK delegates stay on the main thread.
+
+     With `EchoConfigKey.echoFlushSchedulerEnabled`, an `EchoFlushScheduler` flushes the delegates' caches
+     once they are constructed.
+
+     With `EchoConfigKey.echoCollectorURL` set, an `EchoCollectorDelegate` is added to the factory's delegates.
+
+     `configuration` is `config` already collated, e.g. on a background queue by `initialiseInBackground`.
+
+     `userStateStore` defaults to the store in the app's support directory.
+
+     `prepared` supplies the configuration, user state and device ID read off the main thread by
+     `initialiseInBackground`, in place of `configuration` and `userStateStore`.
+
+     `clock` is the wall clock the behind-live-edge latency is measured against.
+     */
     internal init(appName: String, appType: ApplicationType, startCounterName: String, config: [EchoConfigKey: String]?,
                   echoDelegateFactory: EchoDelegateFactoryProtocol, device: EchoDeviceDelegate,
-                  brokerFactory: BrokerFactoryProtocol, bbcUser: BBCUser) throws {
+                  brokerFactory: BrokerFactoryProtocol, bbcUser: BBCUser,
+                  delegateConstructionDelay: TimeInterval? = nil, webviewStorage: EchoWebviewStorage? = nil,
+                  delegateIsolation: IsolatedDelegate.Configuration? = nil,
+                  configuration: EchoConfiguration? = nil, userStateStore: EchoUserStateStore? = nil,
+                  prepared: EchoPreparedInitialisation? = nil, clock: TimeProtocol = SystemClock()) throws {
+
+        let profiler = EchoStartupProfiler(enabled: EchoClient.startupProfilingEnabled)
+        self.startupProfiler = profiler
 
-        var collatedConfig = EchoClient.collateConfig(config)
+        // Set up logging first so that any validation errors are reported
+        EchoClient.applyDebugLevel(EchoConfiguration.debugLevel(for: config?[.echoDebug]))
+
+        let configuration = try prepared?.configuration ?? configuration ?? profiler.measure("config") {
+            try EchoConfiguration(appName: appName, config: config)
+        }
+        EchoClient.applyDebugLevel(configuration.debugLevel)
 
         self.brokerFactory = brokerFactory
         self.device = device
+        self.clock = clock
 
         self.labelCleanser = LabelCleanser.getInstance()
 
-        self.essUrl = collatedConfig[.essURL]
+        self.essUrl = configuration.essURL
         self.useHttps = true
 
-        self.essEnabled = collatedConfig[.useESS] == "true"
+        self.essEnabled = configuration.useESS
 
-        switch collatedConfig[.echoDebug] {
-        case "true":
-            EchoDebug.isDebugEnabled = true
-            EchoDebug.level = .warn
-        case "info":
-            EchoDebug.isDebugEnabled = true
-            EchoDebug.level = .info
-        case "warn":
-            EchoDebug.isDebugEnabled = true
-            EchoDebug.level = .warn
-        case "error":
-            EchoDebug.isDebugEnabled = true
-            EchoDebug.level = .error
-        default:
-            EchoDebug.isDebugEnabled = false
-        }
-
-        self.idv5Enabled = collatedConfig[.idv5Enabled] == "true"
+        self.idv5Enabled = configuration.idv5Enabled
 
-        self.cacheMode = EchoCacheMode.getEnum(collatedConfig[.echoCacheMode] ?? "offline")
+        self.cacheMode = configuration.cacheMode
 
-        self.echoEnabled = collatedConfig[.echoEnabled] == "true"
+        self.echoEnabled = configuration.enabled
 
-        self.autoStart = collatedConfig[.echoAutoStart] == "true"
+        self.autoStart = configuration.autoStart
 
         let cleanAppName = labelCleanser.cleanLabelValue(EchoLabelKeys.BBCApplicationName.rawValue, value: appName)
         let cleanStartCounterName = labelCleanser.cleanCountername(startCounterName)
 
-        self.userPromiseHelper = UserPromiseHelper(device: self.device, webviewCookiesEnabled: collatedConfig[.webviewCookiesEnabled] == "true")
-        var deviceId = collatedConfig[.echoDeviceID] ?? device.getDeviceID()
-        if deviceId.trim().isEmpty {
-            deviceId = device.getDeviceID()
+        self.userPromiseHelper = profiler.measure("userPromiseHelper") {
+            UserPromiseHelper(device: device, webviewCookiesEnabled: configuration.webviewCookiesEnabled)
+        }
+        self.userStateStore = prepared?.userStateStore ?? profiler.measure("userState") {
+            userStateStore ?? EchoUserStateStore()
+        }
+        let deviceId = prepared?.deviceID ?? profiler.measure("deviceID") { () -> String in
+            let configured = configuration.deviceID ?? device.getDeviceID()
+            return configured.trim().isEmpty ? device.getDeviceID() : configured
         }
         if !idv5Enabled {
-            self.userPromiseHelper.clearWebviewCookies()
+            let storage = webviewStorage ?? UserPromiseWebviewStorage(userPromiseHelper)
+            self.webviewStorageTask = profiler.measure("webviewStorage") {
+                EchoWebviewStorageTask.clearingCookies(in: storage)
+            }
         } else {
-            resetDataOnUserStateChangeEnabled = collatedConfig[.comscoreResetDataOnUserStateChange] == "true"
+            resetDataOnUserStateChangeEnabled = configuration.resetDataOnUserStateChange
         }
         self.bbcUserSetWhileDisabled = bbcUser
 
-        delegates = echoDelegateFactory.getDelegates(cleanAppName, appType: appType, startCounterName: cleanStartCounterName,
-                device: device, config: collatedConfig, bbcUser: bbcUser)
+        let delegateConfig = configuration.values
+        let collectorURL = configuration.collectorURL
+        let cachePolicy = configuration.cachePolicy
+        let initialCacheMode = configuration.cacheMode
+        let delegateIsolation = delegateIsolation
+            ?? (configuration.delegateIsolationEnabled ? IsolatedDelegate.Configuration() : nil)
+        let makeDelegates = {
+            profiler.measure("delegates") { () -> [EchoDelegate] in
+                var delegates = echoDelegateFactory.getDelegates(cleanAppName, appType: appType,
+                                                                 startCounterName: cleanStartCounterName, device: device,
+                                                                 config: delegateConfig, bbcUser: bbcUser)
+                if let collectorURL = collectorURL {
+                    delegates.append(EchoCollectorDelegate(appName: cleanAppName, collectorURL: collectorURL,
+                                                           cachePolicy: cachePolicy, cacheMode: initialCacheMode))
+                }
+                guard let isolation = delegateIsolation else {
+                    return delegates
+                }
+                return delegates.map { delegate in
+                    guard let isolatable = delegate as? EchoIsolatableDelegate else {
+                        return delegate
+                    }
+                    return IsolatedDelegate(isolatable, configuration: isolation)
+                }
+            }
+        }
 
-        super.init()
-        if !(try EchoClient.isValidConfig(appName: appName, config: collatedConfig)) {
-            throw EchoInitialisationError.InvalidConfig(reason: "The provided configuration was invalid.")
+        if configuration.eventLogEnabled {
+            do {
+                eventLog = try EchoEventLog(cachePolicy: configuration.cachePolicy)
+            } catch {
+                EchoDebug.log(level: .error, message: "Unable to open the event log: \(error)")
+            }
         }
 
+        let delegateConstructionDelay = delegateConstructionDelay ?? configuration.delegateConstructionDelay
+        if delegateConstructionDelay != nil {
+            let deferred = DeferredDelegates(factory: makeDelegates)
+            deferredDelegates = deferred
+            delegates = [deferred]
+        } else {
+            delegates = makeDelegates()
+        }
+
+        super.init()
+
+        let flushSchedulerEnabled = configuration.flushSchedulerEnabled
+        if let delay = delegateConstructionDelay {
+            deferredDelegates?.onConstructed = { [weak self] constructed in
+                self?.delegates = constructed
+                self?.deferredDelegates = nil
+                self?.replayUndeliveredEvents(to: constructed)
+                if flushSchedulerEnabled {
+                    self?.startFlushScheduler()
+                }
+            }
+            DispatchQueue.main.asyncAfter(deadline: .now() + delay) { [weak self] in
+                self?.constructDelegates()
+            }
+        }
         if self.echoEnabled && self.autoStart {
-            self.start()
+            profiler.measure("start") {
+                self.start()
+            }
+        }
+        if deferredDelegates == nil {
+            replayUndeliveredEvents(to: delegates)
+            if flushSchedulerEnabled {
+                startFlushScheduler()
+            }
         }
 
         EchoDebug.log(level: .info, message: "Library initialised")
+        if let report = profiler.finish() {
+            startupReport = report
+            EchoDebug.log(level: .info, message: "Startup timings:\n\(report)")
+        }
 
         NotificationCenter.default.addObserver(self, selector: #selector(EchoClient.appForegrounded), name: UIApplication.willEnterForegroundNotification, object: nil)
 
@@ -170,6 +305,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         suppressingPlayEvent = false
 
         self.media = media
+        invalidateLiveClock()
 
         for delegate in delegates {
             delegate.liveMediaUpdate(media, newPosition: newPosition, oldPosition: oldPosition)
@@ -178,8 +314,67 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
     }
 
     @objc func liveTimestampUpdate(_ timestamp: TimeInterval) {
-        let timestamp = UInt64(timestamp * 1000)
-        addLabel(EchoLabelKeys.MediaTimestamp.rawValue, value: String(timestamp))
+        // The player timestamp is the wall clock time of the point being played, so the live edge is now
+        liveEdgeLatency.record(EchoTimestamp(currentTimestamp: timestamp, liveEdgeTimestamp: clock.currentTime()))
+
+        // AV events carry a MediaTimestamp derived from their position. The label is only pushed to the
+        // delegates, for their heartbeats and non-AV events, when a sample is due rather than every tick.
+        guard liveClock.sampleDue(at: timestamp) else {
+            return
+        }
+
+        liveClock.sample(timestamp: timestamp, position: broker?.getPosition() ?? 0)
+        pushMediaTimestamp(timestamp)
+    }
+
+    /// Sets the MediaTimestamp label, read by vendor heartbeats and non-AV events, unless it already holds `timestamp`
+    private func pushMediaTimestamp(_ timestamp: TimeInterval) {
+        let value = String(UInt64((timestamp * 1000).rounded()))
+        guard value != mediaTimestampLabel else {
+            return
+        }
+
+        mediaTimestampLabel = value
+        addLabel(EchoLabelKeys.MediaTimestamp.rawValue, value: value)
+    }
+
+    /**
+     Drops the offset after a discontinuity such as a seek, along with the MediaTimestamp label derived
+     from it, so nothing carries a pre-discontinuity timestamp until the player timestamp is sampled again.
+     */
+    private func invalidateLiveClock() {
+        liveClock.invalidate()
+        if mediaTimestampLabel != nil {
+            mediaTimestampLabel = nil
+            removeLabel(EchoLabelKeys.MediaTimestamp.rawValue)
+        }
+    }
+
+    private func addingLiveEdgeLatency(to labels: [String: String]?) -> [String: String]? {
+        guard let media = media, media.isLive, liveEdgeLatency.sampleCount > 0 else {
+            return labels
+        }
+
+        var labels = labels ?? [String: String]()
+        for (key, value) in liveEdgeLatency.labels() {
+            labels[key] = value
+        }
+        return labels
+    }
+
+    /**
+     Adds the MediaTimestamp derived from `position` to an AV event's labels. The persistent label is
+     resampled to the same value, so the vendors' own heartbeats do not carry an older one.
+     */
+    private func addingLiveTimestamp(to labels: [String: String]?, at position: UInt64) -> [String: String]? {
+        guard let media = media, media.isLive, let timestamp = liveClock.timestamp(at: position) else {
+            return labels
+        }
+
+        pushMediaTimestamp(timestamp)
+        var labels = labels ?? [String: String]()
+        labels[EchoLabelKeys.MediaTimestamp.rawValue] = String(UInt64((timestamp * 1000).rounded()))
+        return labels
     }
 
     func setEssError(_ error: EssError, code: String) {
@@ -210,7 +405,8 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
     }
 
     @objc func sendHeartbeat(withName name: String, position: UInt64) {
-        avUserActionEvent(actionType: "echo_hb", actionName: name, position: position, eventLabels: nil)
+        avUserActionEvent(actionType: "echo_hb", actionName: name, position: position,
+                          eventLabels: addingLiveEdgeLatency(to: nil))
     }
 
     public func getAPIVersion() -> String {
@@ -222,6 +418,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
     }
 
     public func getComScoreDeviceID() -> String? {
+        constructDelegates()
         var deviceID: String?
 
         for delegate in delegates {
@@ -244,12 +441,16 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
      - site: The Destination Enum representing the site
      */
     @objc public func setDestination(site: Destination) {
+        persistentLabels.set(.destination, String(site.rawValue))
+
         for delegate in delegates {
             delegate.setDestination(site)
         }
     }
 
     @objc public func setProducer(site: Producer) {
+        persistentLabels.set(.producer, String(site.rawValue))
+
         for delegate in delegates {
             delegate.setProducer(site)
         }
@@ -257,9 +458,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
 
     @objc public func setProducer(name: String) {
         if let producer = Producer.producerFromName(name) {
-            for delegate in delegates {
-                delegate.setProducer(producer)
-            }
+            setProducer(site: producer)
         } else {
             EchoDebug.log(level: .warn, message: "Producer name not recognised. Keeping current producer")
         }
@@ -267,10 +466,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
 
     @objc public func setProducerByMasterbrand(_ masterbrandName: String) {
         if let masterbrand = Masterbrand.MasterbrandFromName(masterbrandName) {
-            let producer: Producer = masterbrand.producer
-            for delegate in delegates {
-                delegate.setProducer(producer)
-            }
+            setProducer(site: masterbrand.producer)
         } else {
             EchoDebug.log(level: .warn, message: "Producer name not recognised. Keeping current producer")
         }
@@ -365,6 +561,10 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             media = nil
         }
 
+        liveClock.invalidate()
+        mediaTimestampLabel = nil
+        liveEdgeLatency.reset()
+
         if let broker = broker {
             broker.stop()
             self.broker = nil
@@ -443,12 +643,16 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             sanitisedLabels = sanitiseLabels(eventLabels)
         }
 
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
+
         if media.isLive && media.isEnrichedWithESSData && suppressingPlayEvent {
             suppressedPlayEventLabels = sanitisedLabels
         } else {
+            let sequence = logEvent(EchoEventRecord(kind: .avPlay, position: position, labels: sanitisedLabels))
             for delegate in delegates {
                 delegate.avPlayEvent(at: position, eventLabels: sanitisedLabels)
             }
+            didDispatchEvent(sequence)
             self.media?.isPlaying = true
             self.media?.isBuffering = false
             mediaActive = true
@@ -476,12 +680,15 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         }
 
         position = avNavigationEvent(position: position)
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
 
         media.isPlaying = false
 
+        let sequence = logEvent(EchoEventRecord(kind: .avPause, position: position, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.avPauseEvent(at: position, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
 
     }
 
@@ -506,12 +713,17 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         }
 
         position = avNavigationEvent(position: position)
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
 
         media.isPlaying = false
 
+        let sequence = logEvent(EchoEventRecord(kind: .avBuffer, position: position, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.avBufferEvent(at: position, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
+
+        invalidateLiveClock()
 
         media.isBuffering = true
 
@@ -538,12 +750,17 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         }
 
         position = avNavigationEvent(position: position)
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
+
+        sanitisedLabels = addingLiveEdgeLatency(to: sanitisedLabels)
 
         self.media?.isPlaying = false
 
+        let sequence = logEvent(EchoEventRecord(kind: .avEnd, position: position, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.avEndEvent(at: position, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
 
         self.media = nil
         mediaActive = false
@@ -571,10 +788,13 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         }
 
         position = avNavigationEvent(position: position)
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
 
+        let sequence = logEvent(EchoEventRecord(kind: .avRewind, position: position, rate: rate, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.avRewindEvent(at: position, rate: rate, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
 
     }
 
@@ -599,10 +819,13 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         }
 
         position = avNavigationEvent(position: position)
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
 
+        let sequence = logEvent(EchoEventRecord(kind: .avFastForward, position: position, rate: rate, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.avFastForwardEvent(at: position, rate: rate, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
 
     }
 
@@ -628,10 +851,15 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         }
 
         position = avNavigationEvent(position: position)
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
 
+        let sequence = logEvent(EchoEventRecord(kind: .avSeek, position: position, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.avSeekEvent(at: position, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
+
+        invalidateLiveClock()
     }
 
     public func avUserActionEvent(actionType: String, actionName: String, position: UInt64, eventLabels: [String: String]?) {
@@ -662,9 +890,13 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             }
         }
 
+        sanitisedLabels = addingLiveTimestamp(to: sanitisedLabels, at: position)
+
+        let sequence = logEvent(EchoEventRecord(kind: .avUserAction, name: actionName, type: actionType, position: position, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.avUserActionEvent(actionType: actionType, actionName: actionName, position: position, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
     }
 
     private func avNavigationEvent(position: UInt64) -> UInt64 {
@@ -709,9 +941,19 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             return
         }
 
-        for delegate in delegates {
+        for delegate in delegates where EchoClient.acknowledgingTarget(delegate) == nil {
             delegate.flushCache()
         }
+
+        let acknowledging = EchoClient.acknowledgingTargets(delegates)
+        if !acknowledging.isEmpty {
+            let acknowledged = EchoClient.acknowledgement(of: eventLog)
+            EchoFlushScheduler.flush(acknowledging, on: .main) { _, failed in
+                acknowledged(!failed)
+            }
+        }
+
+        eventLog?.checkpoint()
     }
 
     /**
@@ -724,9 +966,13 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         for delegate in delegates {
             delegate.clearCache()
         }
+
+        eventLog?.clear()
     }
 
     public func setContentLanguage(_ language: String) {
+        persistentLabels.set(.contentLanguage, language)
+
         for delegate in delegates {
             delegate.setContentLanguage(language)
         }
@@ -748,6 +994,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             if deviceIDResetReason != nil {
                 EchoDebug.log(level: .info, message: "Clearing cache and internal data due to session and device id change")
                 self.clearCache()
+                userStateStore.clear()
             }
             if let tokenRefreshTimestamp = user.tokenRefreshTimestamp {
                 scheduleTokenExpiry(tokenRefreshTimestamp, user: user)
@@ -764,9 +1011,11 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             for delegate in delegates {
                 delegate.userStateChange()
             }
+            userLabelsSent = nil
             // we can not send the 'user_state_change' event so persist the state change event type
             // so it can be picked up the next time Echo starts
             self.userPromiseHelper.setPostponedUserStateTransition(userStateTransition: userPromiseHelperResult.userStateTransition)
+            userStateStore.update { $0.postponedUserStateTransition = userPromiseHelperResult.userStateTransition.rawValue }
             return
         }
     }
@@ -783,6 +1032,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         // This ensures that the persistent data is cleared and we only send the event once
         if userPromiseHelperResult.isPostponedUserStateChange {
             userPromiseHelper.clearPostponedUserStateTransition()
+            userStateStore.update { $0.postponedUserStateTransition = nil }
         }
     }
 
@@ -813,6 +1063,11 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
 
         // set previous user from local storage if not already set
         previousUser = previousUser ?? userPromiseHelper.getBBCUser()
+        // after any reset below, so the record starts again from this user
+        defer { recordUserState(user) }
+
+        // the helper writes webview cookies, which must not be wiped by a clear still queued from init
+        webviewStorageTask?.runPendingWork()
 
         // update local storage based on incoming user
         userPromiseHelperResult = userPromiseHelper.setBBCUser(user)
@@ -833,6 +1088,8 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
 
         //reset the device id and update event labels, name and type
         if let deviceIDResetReason = deviceIDResetReason {
+            // the delegates' user labels are rebuilt in full after a reset
+            userLabelsSent = nil
             resetDeviceId(deviceIDResetReason, userPromiseHelperResult)
             if resetDataOnUserStateChangeEnabled && deviceIDResetReason == .userStateChange {
                 return
@@ -846,10 +1103,8 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             }
         }
 
-        //update user labels stored in delegate
-        for delegate in delegates {
-            delegate.updateBBCUserLabels(user)
-        }
+        //update user labels stored in delegate, if they have changed
+        updateUserLabels(user)
 
          if userPromiseHelperResult.userStateTransition != .none || userPromiseHelperResult.deviceIDResetReason != nil {
             sendUserUpdateEvent(user, actionType, actionName, &eventLabels, userPromiseHelperResult)
@@ -865,6 +1120,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
 
         if !value.isEmpty {
             let cleansedValue = labelCleanser.cleanLabelValue(label.name(), value: value)
+            persistentLabels.add([label.name(): cleansedValue])
 
             for delegate in delegates {
                 delegate.addManagedLabel(label, value: cleansedValue)
@@ -875,6 +1131,7 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
     public func addLabels(_ labels: [String: String]) {
 
         let sanitisedLabels = sanitiseLabels(labels)
+        persistentLabels.add(sanitisedLabels)
 
         for delegate in delegates {
             delegate.addLabels(sanitisedLabels)
@@ -891,6 +1148,8 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         let keys = sanitiseLabels(labels)
 
         if !keys.isEmpty {
+            persistentLabels.remove(keys)
+
             for delegate in delegates {
                 delegate.removeLabels(keys)
             }
@@ -917,6 +1176,114 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         for delegate in delegates {
             delegate.appBackgrounded()
         }
+
+        eventLog?.checkpoint()
+        userStateStore.flush()
+        flushScheduler?.flushWithinBudget()
+    }
+
+    /**
+     Constructs the delegates now if their construction was deferred.
+     */
+    internal func constructDelegates() {
+        deferredDelegates?.construct()
+    }
+
+    /**
+     Flushes the delegates' caches in scheduled windows from now on, rather than only when
+     `flushCache()` is called. Delegates which report on their uploads are waited for and counted.
+     */
+    internal func startFlushScheduler(reachability: ReachabilitySource = SystemReachability(),
+                                      configuration: EchoFlushScheduler.Configuration = EchoFlushScheduler.Configuration()) {
+        flushScheduler?.stop()
+        constructDelegates()
+
+        let targets = delegates.map { ($0 as? EchoFlushTarget) ?? EchoDelegateFlushTarget($0) }
+        let scheduler = EchoFlushScheduler(targets: targets, reachability: reachability, configuration: configuration)
+        let eventLog = self.eventLog
+        scheduler.acknowledge = {
+            EchoClient.acknowledgement(of: eventLog)
+        }
+        scheduler.start()
+        flushScheduler = scheduler
+    }
+
+    private func logEvent(_ record: @autoclosure () -> EchoEventRecord) -> UInt64? {
+        guard let eventLog = eventLog else {
+            return nil
+        }
+
+        return eventLog.append(record(), snapshot: persistentLabels)
+    }
+
+    private func didDispatchEvent(_ sequence: UInt64?) {
+        guard let sequence = sequence, let eventLog = eventLog else {
+            return
+        }
+
+        eventLog.markDispatched(through: sequence)
+        if EchoClient.acknowledgingTargets(delegates).isEmpty {
+            eventLog.markDelivered(through: sequence)
+        }
+    }
+
+    /**
+     The delegates which report back once an upload is accepted, looking through isolation. While there
+     are any, logged events are only marked delivered once a flush of them all succeeds. The vendor SDKs
+     keep their own offline caches, so without any an event counts as delivered once handed over.
+     */
+    internal static func acknowledgingTargets(_ delegates: [EchoDelegate]) -> [EchoFlushTarget] {
+        return delegates.compactMap(acknowledgingTarget)
+    }
+
+    internal static func acknowledgingTarget(_ delegate: EchoDelegate) -> EchoFlushTarget? {
+        if let isolated = delegate as? IsolatedDelegate {
+            return isolated.wrapped is EchoFlushTarget ? isolated : nil
+        }
+        return delegate as? EchoFlushTarget
+    }
+
+    /**
+     Called as a flush starts. Returns what to do once it finishes: mark the events dispatched by now
+     delivered if every target sent or handed off what it held.
+     */
+    private static func acknowledgement(of eventLog: EchoEventLog?) -> (_ succeeded: Bool) -> Void {
+        guard let eventLog = eventLog else {
+            return { _ in }
+        }
+
+        let through = eventLog.dispatchedThrough
+        return { succeeded in
+            if succeeded {
+                eventLog.markDelivered(through: through)
+            }
+        }
+    }
+
+    /**
+     Replays events logged by earlier sessions which were never marked as delivered, for example because
+     the app was terminated before the delegates sent them. Called once the delegates are constructed.
+     Only the delegates which acknowledge uploads are replayed to; the vendor SDKs keep their own offline
+     caches, so they already hold whatever they were handed.
+     */
+    internal func replayUndeliveredEvents(to delegates: [EchoDelegate]) {
+        guard echoEnabled, let eventLog = eventLog else {
+            return
+        }
+
+        let acknowledging = delegates.filter { EchoClient.acknowledgingTarget($0) != nil }
+        guard !acknowledging.isEmpty else {
+            eventLog.markDelivered(through: replayThrough)
+            return
+        }
+
+        let replayedLabels = eventLog.replayUndelivered(to: acknowledging, through: replayThrough)
+        guard !replayedLabels.isEmpty else {
+            return
+        }
+
+        // Put back the labels in effect now, in place of those the replayed events were logged with
+        PersistentLabelSnapshot.apply(persistentLabels.labels, replacing: replayedLabels, to: acknowledging)
     }
 
     public func viewEvent(counterName: String, eventLabels: [String: String]?) {
@@ -934,9 +1301,11 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
 
         counterNameSet = true
 
+        let sequence = logEvent(EchoEventRecord(kind: .view, name: cleansedCounterName, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.viewEvent(counterName: cleansedCounterName, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
     }
 
     public func userActionEvent(actionType: String, actionName: String, eventLabels: [String: String]?) {
@@ -958,9 +1327,11 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         // No clean up of actionType and actionName as they are values
         // which will get put against keys. We don't clean values.
 
+        let sequence = logEvent(EchoEventRecord(kind: .userAction, name: actionName, type: actionType, labels: sanitisedLabels))
         for delegate in delegates {
             delegate.userActionEvent(actionType: actionType, actionName: actionName, eventLabels: sanitisedLabels)
         }
+        didDispatchEvent(sequence)
     }
 
     public func errorEvent(_ error: String, eventLabels: [String: String]?) {
@@ -974,9 +1345,11 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
             eventLabels = sanitiseLabels(labels)
         }
 
+        let sequence = logEvent(EchoEventRecord(kind: .error, name: error, labels: eventLabels))
         for delegate in delegates {
             delegate.errorEvent(error, eventLabels: eventLabels)
         }
+        didDispatchEvent(sequence)
     }
 
     private func sanitiseLabels(_ labels: [String]) -> [String] {
@@ -1034,7 +1407,9 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         }
 
         for delegate in delegates {
-            delegate.start()
+            startupProfiler.measure("start.\(type(of: delegate))") {
+                delegate.start()
+            }
         }
 
         self._hasStarted = true
@@ -1060,40 +1435,6 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         return sanitisedLabels
     }
 
-    private class func collateConfig(_ userConfig: [EchoConfigKey: String]?) -> [EchoConfigKey: String] {
-
-        var config = [EchoConfigKey: String]()
-
-        // Get default Echo config
-        config.merge(getDefaultConfig())
-
-        // Get defaults for each delegate
-        config.merge(ComScoreDelegate.getDefaultConfig())
-        config.merge(SpringDelegate.getDefaultConfig())
-        config.merge(ATInternetDelegate.getDefaultConfig())
-
-        // Check if user has provided configuration
-        if let userConfig = userConfig {
-
-            // Get reporting profile data and add to config
-            if let profile = userConfig[.reportingProfile],
-               let echoProfile = EchoProfile(rawValue: profile.lowercased()) {
-                config.merge(EchoReportingProfiles.getConfigForProfile(echoProfile))
-            }
-
-            // Add user provided overrides where appropriate
-            for (key, value) in userConfig where !value.isEmpty {
-                config[key] = value
-            }
-        }
-
-        // These are set last as a user should not be able to override them
-        config[.measurementLibName] = EchoClient.LibraryName
-        config[.measurementLibVersion] = EchoClient.LibraryVersion
-
-        return config
-    }
-
     @objc internal class func getDefaultConfig() -> [EchoConfigKey: String] {
         var config = [EchoConfigKey: String]()
         config[.echoEnabled] = "true"
@@ -1117,82 +1458,12 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
         return position
     }
 
-    /**
-     Validates the provided application name, application type and configuration.
-     - parameters:
-        - appName: The application name
-        - appType: The app type
-        - config: The collection of custom configurations
-    */
-    private class func isValidConfig(appName: String, config: [EchoConfigKey: String]) throws -> Bool {
-        // Echo Enabled - Must be true or false
-        let boolValid = ["true", "false"]
-        guard validateConfigField(key: .echoEnabled, value: config[.echoEnabled], valid: boolValid, options: []),
-              // Echo Auto-Start - Must be true or false
-              validateConfigField(key: .echoAutoStart, value: config[.echoAutoStart], valid: boolValid, options: []),
-              // Application Name - Can't be null, empty or only whitespace.
-              validateConfigField(key: .applicationName, value: appName, valid: [], options: [.nonZeroLength, .noWhiteSpace]),
-              // Cache mode must be a permitted value
-              validateConfigField(key: .echoCacheMode, value: config[.echoCacheMode], valid: ["offline", "all"], options: []),
-              // comscore enabled must be true or false
-              validateConfigField(key: .comScoreEnabled, value: config[.comScoreEnabled], valid: boolValid, options: [.optional]),
-              // comscore debug more must be "0" or "1"
-              validateConfigField(key: .comScoreDebugMode, value: config[.comScoreDebugMode], valid: ["0", "1"], options: [.optional]),
-              // test service enabled must be true or false
-              validateConfigField(key: .testServiceEnabled, value: config[.testServiceEnabled], valid: boolValid, options: [.optional]),
-              // use ess must be true or false
-              validateConfigField(key: .useESS, value: config[.useESS], valid: boolValid, options: []),
-              // ess_https_enabled must be true or false
-              validateConfigField(key: .essHTTPSEnabled, value: config[.essHTTPSEnabled], valid: boolValid, options: []),
-              // idv5_enabled must be true or false
-              validateConfigField(key: .idv5Enabled, value: config[.idv5Enabled], valid: boolValid, options: [.optional]),
-              // webview cookies enabled must be true or false,
-              validateConfigField(key: .webviewCookiesEnabled, value: config[.webviewCookiesEnabled], valid: boolValid, options: [.optional]),
-              // barbEnabled must be true or false
-              validateConfigField(key: .barbEnabled, value: config[.barbEnabled], valid: boolValid, options: [.optional])
-        else {
-            return false
-        }
-
-        return true
-    }
-
-    /**
-     validates that a given value is valid against a supplied list of valid values.
-     Providing an empty list treats treats all strings as valid unless additional rules in options are met.
-     Additional rules test for non zero and no white space.
-    */
-    private class func validateConfigField(key: EchoConfigKey, value: String?, valid: [String], options: [EchoConfigValidationOptions]) -> Bool {
-        if options.contains(.optional) && value == nil {
-            return true
-        } else if !options.contains(.optional) && value == nil {
-            EchoDebug.log(level: .error, message: "Missing Config Argument: \(key)")
-            return false
-        }
-
-        guard let value = value else {
-            return false
-        }
-
-        if options.contains(.nonZeroLength) {
-            if value.count == 0 {
-                EchoDebug.log(level: .error, message: "\(key) cannot be empty. Not Valid: \(value)")
-                return false
-            }
-        }
-
-        if options.contains(.noWhiteSpace) {
-            if value.range(of: "\\A\\s*\\z", options: .regularExpression) != nil {
-                EchoDebug.log(level: .error, message: "\(key) cannot be empty. Not Valid: \(value)")
-                return false
-            }
-        }
-
-        if valid.count == 0 || valid.contains(value) {
-            return true
+    private class func applyDebugLevel(_ level: EchoErrorLevel?) {
+        if let level = level {
+            EchoDebug.isDebugEnabled = true
+            EchoDebug.level = level
         } else {
-            EchoDebug.log(level: .error, message: "\(key) must equal one of \(valid). Not valid: \(value)")
-            return false
+            EchoDebug.isDebugEnabled = false
         }
     }
 
@@ -1217,42 +1488,49 @@ public class EchoClient: NSObject, EchoLibrary, LiveProtocol, OnDemandProtocol {
     }
 
     private func scheduleTokenExpiry(_ tokenRefreshTimestamp: Date, user: BBCUser) {
-        // stop existing schedule (waiting for new token)
-        removeSchedule()
-
-        let timeUntilExpiry = user.getTimeUntilTokenExpiry()
-
-        // can't pass user object through timer as it has optionals which aren't objc compatible
-        // so we assign it to a global variable so the expireToken method can read it
-        userForTimer = user
-
-        if timeUntilExpiry > 0 {
-            timer = Timer(timeInterval: timeUntilExpiry,
-                          target: self,
-                          selector: #selector(expireToken),
-                          userInfo: nil,
-                          repeats: false)
+        tokenExpiry.schedule(user, timeUntilExpiry: user.getTimeUntilTokenExpiry())
+    }
 
-            RunLoop.current.add(timer, forMode: RunLoop.Mode.common)
+    private func expireToken(_ user: BBCUser) {
+        updateUserLabels(user)
+    }
 
-            EchoDebug.log(level: .info, message: "Scheduler set to check token in \(timeUntilExpiry) seconds")
+    /**
+     Updates the delegates' user labels from `user` unless none of the fields they are derived from have
+     changed since the last update, e.g. when the same user is set again on each foreground.
+     */
+    private func updateUserLabels(_ user: BBCUser) {
+        let labels = EchoUserLabels(user)
+        let changes = labels.changes(from: userLabelsSent)
+        guard !changes.isEmpty else {
+            return
         }
 
+        EchoDebug.log(level: .info, message: "User labels changed: \(changes)")
+        let current = labels.labels
+        persistentLabels.remove(EchoUserLabels.keys.filter { current[$0] == nil })
+        persistentLabels.add(current)
+        userLabelsSent = labels
+        for delegate in delegates {
+            delegate.updateBBCUserLabels(user)
+        }
     }
 
-    @objc private func expireToken() {
-        if let userForTimer = userForTimer {
-            for delegate in delegates {
-                delegate.updateBBCUserLabels(userForTimer)
+    /// Copies what the `UserPromiseHelper` now holds for `user` into the user state record
+    private func recordUserState(_ user: BBCUser) {
+        let deviceID = userPromiseHelper.getDeviceID()
+        userStateStore.update { state in
+            state.signedIn = user.signedIn
+            state.hashedID = user.hashedID
+            state.tokenRefreshTimestamp = user.tokenRefreshTimestamp
+            if let deviceID = deviceID {
+                state.deviceID = deviceID
             }
         }
-        userForTimer = nil
     }
 
     private func removeSchedule() {
-        if let timer = timer {
-            timer.invalidate()
-        }
+        tokenExpiry.cancel()
     }
 
     @objc public var hasStarted: Bool {
@@ -0,0 +1,215 @@
+//
+//  EchoClientHandle.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Handle to an `EchoClient` which is being initialised in the background, returned by
+ `EchoClient.initialiseInBackground`. Only `prepare` runs in the background; the client itself is
+ created on the main thread afterwards, as it registers for notifications and touches UIKit and the
+ delegates. Calls made before the client is ready are queued and replayed to it, in the order they
+ were made, as soon as it is; calls made after that go straight to the client. If initialisation fails,
+ queued calls are dropped and `error` is set.
+
+ Like `EchoClient`, the handle expects to be called from the main thread.
+ */
+public final class EchoClientHandle: NSObject {
+
+    private var pending = [(EchoClient) -> Void]()
+    private var readyCallbacks = [(EchoClient?) -> Void]()
+
+    /// The client, once initialised
+    public private(set) var client: EchoClient?
+    public private(set) var error: Error?
+
+    internal init<Prepared>(queue: DispatchQueue = DispatchQueue.global(qos: .userInitiated),
+                            prepare: @escaping () throws -> Prepared,
+                            initialiser: @escaping (Prepared) throws -> EchoClient) {
+        super.init()
+
+        queue.async {
+            let prepared: Prepared?
+            let error: Error?
+
+            do {
+                prepared = try prepare()
+                error = nil
+            } catch let preparationError {
+                prepared = nil
+                error = preparationError
+            }
+
+            DispatchQueue.main.async {
+                guard let prepared = prepared else {
+                    self.finish(nil, error: error)
+                    return
+                }
+
+                do {
+                    self.finish(try initialiser(prepared), error: nil)
+                } catch let initialisationError {
+                    self.finish(nil, error: initialisationError)
+                }
+            }
+        }
+    }
+
+    public var isReady: Bool {
+        return client != nil
+    }
+
+    /// Calls queued waiting for the client
+    internal var pendingCallCount: Int {
+        return pending.count
+    }
+
+    private func finish(_ client: EchoClient?, error: Error?) {
+        if let client = client {
+            self.client = client
+            for call in pending {
+                call(client)
+            }
+            EchoDebug.log(level: .info, message: "Background initialisation finished, replayed \(pending.count) calls")
+        } else {
+            self.error = error
+            EchoDebug.log(level: .error, message: "Background initialisation failed, dropping \(pending.count) calls: \(String(describing: error))")
+        }
+
+        pending.removeAll()
+
+        let callbacks = readyCallbacks
+        readyCallbacks.removeAll()
+        callbacks.forEach { $0(client) }
+    }
+
+    /**
+     Runs `call` with the client now if it is ready, or queues it behind any other calls until it is.
+     */
+    public func perform(_ call: @escaping (EchoClient) -> Void) {
+        if let client = client {
+            call(client)
+        } else if error == nil {
+            pending.append(call)
+        }
+    }
+
+    /**
+     Calls `callback` once initialisation has finished, with nil if it failed. Queued calls have
+     already been replayed by then.
+     */
+    public func whenReady(_ callback: @escaping (EchoClient?) -> Void) {
+        if client != nil || error != nil {
+            callback(client)
+        } else {
+            readyCallbacks.append(callback)
+        }
+    }
+
+    // MARK: - Calls commonly made during launch
+
+    public func viewEvent(counterName: String, eventLabels: [String: String]?) {
+        perform { $0.viewEvent(counterName: counterName, eventLabels: eventLabels) }
+    }
+
+    public func userActionEvent(actionType: String, actionName: String, eventLabels: [String: String]?) {
+        perform { $0.userActionEvent(actionType: actionType, actionName: actionName, eventLabels: eventLabels) }
+    }
+
+    public func errorEvent(_ error: String, eventLabels: [String: String]?) {
+        perform { $0.errorEvent(error, eventLabels: eventLabels) }
+    }
+
+    public func setBBCUser(_ user: BBCUser) {
+        perform { $0.setBBCUser(user) }
+    }
+
+    public func setCounterName(_ counterName: String) {
+        perform { $0.setCounterName(counterName) }
+    }
+
+    public func setContentLanguage(_ language: String) {
+        perform { $0.setContentLanguage(language) }
+    }
+
+    public func setDestination(site: Destination) {
+        perform { $0.setDestination(site: site) }
+    }
+
+    public func setProducer(site: Producer) {
+        perform { $0.setProducer(site: site) }
+    }
+
+    public func addLabels(_ labels: [String: String]) {
+        perform { $0.addLabels(labels) }
+    }
+
+    public func addLabel(_ key: String, value: String) {
+        perform { $0.addLabel(key, value: value) }
+    }
+
+    public func removeLabels(_ labels: [String]) {
+        perform { $0.removeLabels(labels) }
+    }
+
+    public func removeLabel(_ key: String) {
+        perform { $0.removeLabel(key) }
+    }
+
+}
+
+/**
+ The parts of an `EchoClient`'s initialisation which are safe off the main thread: collating and
+ validating the config, loading the user state record and reading the device ID.
+ */
+internal struct EchoPreparedInitialisation {
+
+    let configuration: EchoConfiguration
+    let userStateStore: EchoUserStateStore
+    let deviceID: String
+
+    init(appName: String, config: [EchoConfigKey: String]?, device: EchoDeviceDelegate,
+         userStateStore: () -> EchoUserStateStore = { EchoUserStateStore() }) throws {
+        configuration = try EchoConfiguration(appName: appName, config: config)
+        self.userStateStore = userStateStore()
+
+        let configured = configuration.deviceID ?? device.getDeviceID()
+        deviceID = configured.trim().isEmpty ? device.getDeviceID() : configured
+    }
+
+}
+
+extension EchoClient {
+
+    /**
+     Initialises an Echo client without blocking the calling thread. Config collation and validation,
+     loading the user state and reading the device ID happen on a background queue. The client is then created on the main thread, and the vendor
+     delegates are constructed there on a later pass of the run loop, once the client has started. Use
+     the returned handle straight away; calls made through it before the client is ready are replayed in
+     order once it is.
+
+     - parameters:
+        - appName: The name of the containing app
+        - appType: The type of the containing app
+        - startCounterName: The initial counter name used for reporting
+        - config: An optional dictionary containing configuration options
+        - bbcUser: An appropriate BBCUser object
+     */
+    public class func initialiseInBackground(appName: String, appType: ApplicationType, startCounterName: String,
+                                             config: [EchoConfigKey: String]?,
+                                             bbcUser: BBCUser = BBCUser()) -> EchoClientHandle {
+        let device = EchoDevice()
+        return EchoClientHandle(prepare: {
+            try EchoPreparedInitialisation(appName: appName, config: config, device: device)
+        }, initialiser: { prepared in
+            try EchoClient(appName: appName, appType: appType, startCounterName: startCounterName, config: config,
+                           echoDelegateFactory: DefaultDelegateFactory(), device: device,
+                           brokerFactory: BrokerFactory(), bbcUser: bbcUser, delegateConstructionDelay: 0,
+                           prepared: prepared)
+        })
+    }
+
+}
@@ -0,0 +1,56 @@
+//
+//  EchoConfigKeys.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Config keys for Echo's own storage, alongside those declared in `EchoConfigKey.h`.
+ */
+extension EchoConfigKey {
+
+    /// "true" to keep Echo's own log of events, replayed to the delegates if they never acknowledge them
+    public static let echoEventLogEnabled = EchoConfigKey(rawValue: "echo_event_log_enabled")
+
+    /**
+     Seconds to put off constructing the delegates and their SDKs by, so that they are not built during
+     app launch. They are built sooner if an event is sent first. Unset, they are built in init.
+     */
+    public static let echoDelegateConstructionDelay = EchoConfigKey(rawValue: "echo_delegate_construction_delay")
+
+    /**
+     "true" to run each delegate which can be called off the main thread, such as the collector's, on its own
+     queue, so that one which stalls holds up neither the other delegates nor the app. Calls over budget are
+     logged and a delegate which keeps stalling is shed. The vendor SDK delegates stay on the main thread.
+     */
+    public static let echoDelegateIsolationEnabled = EchoConfigKey(rawValue: "echo_delegate_isolation_enabled")
+
+    /**
+     "true" to flush the delegates' caches in scheduled windows, and within a budget when the app is
+     backgrounded, rather than only when `flushCache()` is called.
+     */
+    public static let echoFlushSchedulerEnabled = EchoConfigKey(rawValue: "echo_flush_scheduler_enabled")
+
+    /// URL of an Echo collector to send events to in batches, alongside the vendor SDKs. Unset, none is used
+    public static let echoCollectorURL = EchoConfigKey(rawValue: "echo_collector_url")
+
+    /// Byte budget for the event log while events cannot be sent. Without it the log is unbounded
+    public static let echoCacheMaxBytes = EchoConfigKey(rawValue: "echo_cache_max_bytes")
+
+    /// "heartbeats_first" (the default) or "oldest_first"
+    public static let echoCacheEviction = EchoConfigKey(rawValue: "echo_cache_eviction")
+
+    /// "false" to evict play and end events as readily as any other
+    public static let echoCacheKeepStartAndEnd = EchoConfigKey(rawValue: "echo_cache_keep_start_end")
+
+    /// Byte quota for one delegate's own queue, keyed by delegate name, e.g. `echoCacheQuota("collector")`
+    public static func echoCacheQuota(_ delegate: String) -> EchoConfigKey {
+        return EchoConfigKey(rawValue: echoCacheQuotaPrefix + delegate)
+    }
+
+    internal static let echoCacheQuotaPrefix = "echo_cache_quota_"
+
+}
@@ -0,0 +1,195 @@
+//
+//  EchoConfiguration.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Echo's configuration, collated and validated once when a client is created.
+
+ Defaults, delegate defaults, the reporting profile and the app's own config are layered in one pass,
+ then every field with a restricted set of values is checked against a single table and converted, so
+ the client reads typed values rather than comparing strings. The collated strings are kept in `values`
+ for the delegates, which read their own keys.
+ */
+internal struct EchoConfiguration {
+
+    /**
+     A BBC reporting profile named in the config, with every value `EchoReportingProfiles` sets for it.
+     */
+    struct ReportingProfile: Equatable {
+        let profile: EchoProfile
+        let values: [EchoConfigKey: String]
+
+        init?(named name: String) {
+            guard let profile = EchoProfile(rawValue: name.lowercased()) else {
+                return nil
+            }
+            self.profile = profile
+            values = EchoReportingProfiles.getConfigForProfile(profile)
+        }
+    }
+
+    private struct Rule {
+        let key: EchoConfigKey
+        let allowed: Set<String>
+        let required: Bool
+    }
+
+    private static let booleans: Set<String> = ["true", "false"]
+
+    private static let rules = [
+        Rule(key: .echoEnabled, allowed: booleans, required: true),
+        Rule(key: .echoAutoStart, allowed: booleans, required: true),
+        Rule(key: .echoCacheMode, allowed: ["offline", "all"], required: true),
+        Rule(key: .comScoreEnabled, allowed: booleans, required: false),
+        Rule(key: .comScoreDebugMode, allowed: ["0", "1"], required: false),
+        Rule(key: .testServiceEnabled, allowed: booleans, required: false),
+        Rule(key: .useESS, allowed: booleans, required: true),
+        Rule(key: .essHTTPSEnabled, allowed: booleans, required: true),
+        Rule(key: .idv5Enabled, allowed: booleans, required: false),
+        Rule(key: .webviewCookiesEnabled, allowed: booleans, required: false),
+        Rule(key: .barbEnabled, allowed: booleans, required: false),
+        Rule(key: .echoEventLogEnabled, allowed: booleans, required: false),
+        Rule(key: .echoDelegateIsolationEnabled, allowed: booleans, required: false),
+        Rule(key: .echoFlushSchedulerEnabled, allowed: booleans, required: false)
+    ]
+
+    let enabled: Bool
+    let autoStart: Bool
+    /// nil when debug logging is off
+    let debugLevel: EchoErrorLevel?
+    let cacheMode: EchoCacheMode
+    let essURL: String?
+    let useESS: Bool
+    let essHTTPSEnabled: Bool
+    let idv5Enabled: Bool
+    let webviewCookiesEnabled: Bool
+    let resetDataOnUserStateChange: Bool
+    let deviceID: String?
+    let eventLogEnabled: Bool
+    /// nil to construct the delegates straight away
+    let delegateConstructionDelay: TimeInterval?
+    let delegateIsolationEnabled: Bool
+    let flushSchedulerEnabled: Bool
+    /// nil when no collector is configured
+    let collectorURL: URL?
+    /// nil when no cache budget is configured
+    let cachePolicy: EchoCachePolicy?
+    let reportingProfile: ReportingProfile?
+    /// Every collated value, as passed to the delegates
+    let values: [EchoConfigKey: String]
+
+    /**
+     Collates `userConfig` over the defaults and validates the result, throwing
+     `EchoInitialisationError.InvalidConfig` naming every invalid field.
+     */
+    init(appName: String, config userConfig: [EchoConfigKey: String]?,
+         defaults: [[EchoConfigKey: String]] = EchoConfiguration.defaults()) throws {
+        var values = [EchoConfigKey: String](minimumCapacity: 64)
+
+        for layer in defaults {
+            values.merge(layer) { _, new in new }
+        }
+
+        var profile: ReportingProfile?
+        if let userConfig = userConfig {
+            if let name = userConfig[.reportingProfile], let named = ReportingProfile(named: name) {
+                profile = named
+                values.merge(named.values) { _, new in new }
+            }
+
+            for (key, value) in userConfig where !value.isEmpty {
+                values[key] = value
+            }
+        }
+
+        // These are set last as a user should not be able to override them
+        values[.measurementLibName] = EchoClient.LibraryName
+        values[.measurementLibVersion] = EchoClient.LibraryVersion
+
+        var problems = [String]()
+
+        if appName.trimmingCharacters(in: .whitespacesAndNewlines).isEmpty {
+            problems.append("\(EchoConfigKey.applicationName) cannot be empty. Not Valid: \(appName)")
+        }
+
+        for rule in EchoConfiguration.rules {
+            guard let value = values[rule.key] else {
+                if rule.required {
+                    problems.append("Missing Config Argument: \(rule.key)")
+                }
+                continue
+            }
+            if !rule.allowed.contains(value) {
+                problems.append("\(rule.key) must equal one of \(rule.allowed.sorted()). Not valid: \(value)")
+            }
+        }
+
+        var delegateConstructionDelay: TimeInterval?
+        if let value = values[.echoDelegateConstructionDelay] {
+            if let delay = TimeInterval(value), delay >= 0 {
+                delegateConstructionDelay = delay
+            } else {
+                problems.append("\(EchoConfigKey.echoDelegateConstructionDelay) must be a number of seconds. Not valid: \(value)")
+            }
+        }
+
+        var collectorURL: URL?
+        if let value = values[.echoCollectorURL] {
+            if let url = URL(string: value), ["http", "https"].contains(url.scheme ?? ""), url.host != nil {
+                collectorURL = url
+            } else {
+                problems.append("\(EchoConfigKey.echoCollectorURL) must be an http or https URL. Not valid: \(value)")
+            }
+        }
+
+        guard problems.isEmpty else {
+            problems.forEach { EchoDebug.log(level: .error, message: $0) }
+            throw EchoInitialisationError.InvalidConfig(reason: "The provided configuration was invalid. " + problems.joined(separator: "; "))
+        }
+
+        enabled = values[.echoEnabled] == "true"
+        autoStart = values[.echoAutoStart] == "true"
+        debugLevel = EchoConfiguration.debugLevel(for: values[.echoDebug])
+        cacheMode = EchoCacheMode.getEnum(values[.echoCacheMode] ?? "offline")
+        essURL = values[.essURL]
+        useESS = values[.useESS] == "true"
+        essHTTPSEnabled = values[.essHTTPSEnabled] == "true"
+        idv5Enabled = values[.idv5Enabled] == "true"
+        webviewCookiesEnabled = values[.webviewCookiesEnabled] == "true"
+        resetDataOnUserStateChange = values[.comscoreResetDataOnUserStateChange] == "true"
+        deviceID = values[.echoDeviceID]
+        eventLogEnabled = values[.echoEventLogEnabled] == "true"
+        self.delegateConstructionDelay = delegateConstructionDelay
+        delegateIsolationEnabled = values[.echoDelegateIsolationEnabled] == "true"
+        flushSchedulerEnabled = values[.echoFlushSchedulerEnabled] == "true"
+        self.collectorURL = collectorURL
+        cachePolicy = EchoCachePolicy(config: values)
+        reportingProfile = profile
+        self.values = values
+    }
+
+    /// Echo's defaults followed by each delegate's, lowest priority first
+    static func defaults() -> [[EchoConfigKey: String]] {
+        return [EchoClient.getDefaultConfig(), ComScoreDelegate.getDefaultConfig(),
+                SpringDelegate.getDefaultConfig(), ATInternetDelegate.getDefaultConfig()]
+    }
+
+    static func debugLevel(for value: String?) -> EchoErrorLevel? {
+        switch value {
+        case "true", "warn":
+            return .warn
+        case "info":
+            return .info
+        case "error":
+            return .error
+        default:
+            return nil
+        }
+    }
+
+}
@@ -0,0 +1,75 @@
+//
+//  Broadcast.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ A single item from an ESS schedule.
+
+ Strings are held as references into a `BroadcastStringPool` rather than inline, so a broadcast is a
+ small fixed size record however many times its brand appears in a schedule. There is no default pool:
+ whatever builds a schedule passes the one pool it owns to every broadcast in it.
+ */
+internal struct Broadcast: Equatable {
+
+    let startTime: TimeInterval
+    let endTime: TimeInterval
+
+    private let idRef: BroadcastStringPool.Ref
+    private let versionIdRef: BroadcastStringPool.Ref
+    private let episodeIdRef: BroadcastStringPool.Ref
+    private let episodeTitleRef: BroadcastStringPool.Ref
+    private let brandTitleRef: BroadcastStringPool.Ref
+
+    private let pool: BroadcastStringPool
+
+    init(startTime: TimeInterval, endTime: TimeInterval, episodeId: String, episodeTitle: String,
+         id: String, versionId: String, brandTitle: String, pool: BroadcastStringPool) {
+        self.startTime = startTime
+        self.endTime = endTime
+        self.pool = pool
+        self.idRef = pool.internIdentifier(id)
+        self.versionIdRef = pool.internIdentifier(versionId)
+        self.episodeIdRef = pool.internIdentifier(episodeId)
+        self.episodeTitleRef = pool.internTitle(episodeTitle)
+        self.brandTitleRef = pool.internTitle(brandTitle)
+    }
+
+    var id: String {
+        return pool.identifier(idRef)
+    }
+
+    var versionId: String {
+        return pool.identifier(versionIdRef)
+    }
+
+    var episodeId: String {
+        return pool.identifier(episodeIdRef)
+    }
+
+    var episodeTitle: String {
+        return pool.title(episodeTitleRef)
+    }
+
+    var brandTitle: String {
+        return pool.title(brandTitleRef)
+    }
+
+    static func == (lhs: Broadcast, rhs: Broadcast) -> Bool {
+        if lhs.pool === rhs.pool {
+            return lhs.startTime == rhs.startTime && lhs.endTime == rhs.endTime
+                    && lhs.idRef == rhs.idRef && lhs.versionIdRef == rhs.versionIdRef
+                    && lhs.episodeIdRef == rhs.episodeIdRef && lhs.episodeTitleRef == rhs.episodeTitleRef
+                    && lhs.brandTitleRef == rhs.brandTitleRef
+        }
+
+        return lhs.startTime == rhs.startTime && lhs.endTime == rhs.endTime
+                && lhs.id == rhs.id && lhs.versionId == rhs.versionId && lhs.episodeId == rhs.episodeId
+                && lhs.episodeTitle == rhs.episodeTitle && lhs.brandTitle == rhs.brandTitle
+    }
+
+}
@@ -0,0 +1,114 @@
+//
+//  BroadcastStringPool.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Append-only pool of the strings referenced by the `Broadcast` records of one schedule.
+
+ Multi-day schedules repeat the same brand and episode titles many times over. Each distinct
+ string is stored once and broadcasts hold a 32 bit reference to it. Titles are kept as UTF-8
+ bytes and only turned back into a `String` when they are read, as most delegates only need the IDs.
+
+ A pool lives as long as the schedule whose broadcasts use it, so its strings are released along
+ with the schedule rather than accumulating for the life of the app.
+ */
+internal final class BroadcastStringPool {
+
+    typealias Ref = Int32
+
+    static let empty: Ref = -1
+
+    private let lock = NSLock()
+
+    private var identifiers = [String]()
+    private var identifierRefs = [String: Ref]()
+
+    private var titleBytes = [UInt8]()
+    private var titleRanges = [Range<Int>]()
+    private var titleRefs = [String: Ref]()
+
+    func internIdentifier(_ value: String) -> Ref {
+        if value.isEmpty {
+            return BroadcastStringPool.empty
+        }
+
+        lock.lock()
+        defer { lock.unlock() }
+
+        if let ref = identifierRefs[value] {
+            return ref
+        }
+
+        let ref = Ref(identifiers.count)
+        identifiers.append(value)
+        identifierRefs[value] = ref
+        return ref
+    }
+
+    func identifier(_ ref: Ref) -> String {
+        if ref == BroadcastStringPool.empty {
+            return ""
+        }
+
+        lock.lock()
+        defer { lock.unlock() }
+        return identifiers[Int(ref)]
+    }
+
+    func internTitle(_ value: String) -> Ref {
+        if value.isEmpty {
+            return BroadcastStringPool.empty
+        }
+
+        lock.lock()
+        defer { lock.unlock() }
+
+        if let ref = titleRefs[value] {
+            return ref
+        }
+
+        let start = titleBytes.count
+        titleBytes.append(contentsOf: value.utf8)
+
+        let ref = Ref(titleRanges.count)
+        titleRanges.append(start..<titleBytes.count)
+        titleRefs[value] = ref
+        return ref
+    }
+
+    func title(_ ref: Ref) -> String {
+        if ref == BroadcastStringPool.empty {
+            return ""
+        }
+
+        lock.lock()
+        defer { lock.unlock() }
+        return String(decoding: titleBytes[titleRanges[Int(ref)]], as: UTF8.self)
+    }
+
+    /**
+     Approximate number of bytes held by the pool, used to benchmark schedule memory. Includes the
+     lookup dictionaries: their buckets, and the title keys, which are held as `String`s alongside
+     the UTF-8 copy. Identifier keys share their storage with the `identifiers` entries.
+     */
+    var byteCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+
+        let identifierBytes = identifiers.reduce(0) { $0 + MemoryLayout<String>.stride + $1.utf8.count }
+        let rangeBytes = titleRanges.count * MemoryLayout<Range<Int>>.stride
+        let titleKeyBytes = titleRefs.keys.reduce(0) { $0 + $1.utf8.count }
+        return identifierBytes + titleBytes.count + rangeBytes + titleKeyBytes
+                + BroadcastStringPool.bucketBytes(identifierRefs) + BroadcastStringPool.bucketBytes(titleRefs)
+    }
+
+    private static func bucketBytes(_ refs: [String: Ref]) -> Int {
+        return refs.capacity * (MemoryLayout<String>.stride + MemoryLayout<Ref>.stride)
+    }
+
+}
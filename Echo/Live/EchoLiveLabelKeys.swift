@@ -0,0 +1,24 @@
+//
+//  EchoLiveLabelKeys.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Keys of the labels Echo adds to live AV events, alongside those in `EchoLabelKeys`.
+ */
+public enum EchoLiveLabelKeys: String {
+
+    /// How far behind the live edge playback is, in milliseconds
+    case LiveEdgeLatency = "live_edge_latency"
+
+    /// Median distance behind the live edge over the session, in milliseconds
+    case LiveEdgeLatencyP50 = "live_edge_latency_p50"
+
+    /// 95th percentile distance behind the live edge over the session, in milliseconds
+    case LiveEdgeLatencyP95 = "live_edge_latency_p95"
+
+}
@@ -0,0 +1,91 @@
+//
+//  LiveClockOffsetEstimator.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Tracks the offset between the player's live timestamp and the playhead position so that the
+ media timestamp can be derived from the position when an event is sent, rather than being
+ pushed to every delegate as a label each time the player timestamp changes.
+
+ The offset is sampled once and only re-sampled after a discontinuity: an explicit `invalidate()`
+ (seek, stall, new broadcast) or a sample which drifts further than `driftTolerance` from the estimate.
+
+ Vendor heartbeats and non-AV events still read MediaTimestamp as a persistent label, so it is pushed
+ as one too, but only every `labelInterval` seconds of player time. `sampleDue(at:)` decides when,
+ and the playhead position is only needed for those ticks.
+ */
+internal class LiveClockOffsetEstimator {
+
+    static let defaultDriftTolerance: TimeInterval = 2
+    static let defaultLabelInterval: TimeInterval = 10
+
+    private let driftTolerance: TimeInterval
+    private let labelInterval: TimeInterval
+
+    /// Player timestamp of the last sample taken
+    private var lastSampled: TimeInterval?
+
+    /// Player timestamp minus playhead position, in seconds
+    private(set) var offset: TimeInterval?
+
+    /// Number of times the offset has been (re)established
+    private(set) var sampleCount: Int = 0
+
+    init(driftTolerance: TimeInterval = LiveClockOffsetEstimator.defaultDriftTolerance,
+         labelInterval: TimeInterval = LiveClockOffsetEstimator.defaultLabelInterval) {
+        self.driftTolerance = driftTolerance
+        self.labelInterval = labelInterval
+    }
+
+    /**
+     Whether a player timestamp (seconds) should be sampled and pushed as a label: when there is no
+     offset yet, or when it is at least `labelInterval` from the last sample, in either direction.
+     */
+    func sampleDue(at timestamp: TimeInterval) -> Bool {
+        guard offset != nil, let lastSampled = lastSampled else {
+            return true
+        }
+
+        return abs(timestamp - lastSampled) >= labelInterval
+    }
+
+    /**
+     Offers a player timestamp (seconds) observed at a playhead position (milliseconds).
+     Returns true if the sample was used to establish a new offset.
+     */
+    @discardableResult
+    func sample(timestamp: TimeInterval, position: UInt64) -> Bool {
+        let candidate = timestamp - TimeInterval(position) / 1000
+        lastSampled = timestamp
+
+        if let offset = offset, abs(candidate - offset) <= driftTolerance {
+            return false
+        }
+
+        offset = candidate
+        sampleCount += 1
+        return true
+    }
+
+    func invalidate() {
+        offset = nil
+        lastSampled = nil
+    }
+
+    /**
+     The estimated player timestamp, in seconds, at the given playhead position in milliseconds.
+     */
+    func timestamp(at position: UInt64) -> TimeInterval? {
+        guard let offset = offset else {
+            return nil
+        }
+
+        return offset + TimeInterval(position) / 1000
+    }
+
+}
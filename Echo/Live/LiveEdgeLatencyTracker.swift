@@ -0,0 +1,107 @@
+//
+//  LiveEdgeLatencyTracker.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Running measure of how far behind the live edge playback is, taken from `EchoTimestamp`s pairing each
+ player timestamp the live broker already reports with the wall clock. Samples go into a fixed histogram so recording is constant time and
+ memory stays flat however long the session runs; percentiles are read from the histogram to
+ within one bucket.
+ */
+internal class LiveEdgeLatencyTracker {
+
+    // 250ms buckets for the first minute, where most live playback sits, then 15s buckets up to four hours
+    private static let fineBucketWidth: TimeInterval = 0.25
+    private static let fineBucketCount = 240
+    private static let coarseBucketWidth: TimeInterval = 15
+    private static let coarseBucketCount = 956
+
+    private var buckets = [UInt32](repeating: 0, count: fineBucketCount + coarseBucketCount)
+
+    /// Distance behind the live edge of the most recent sample, in seconds
+    private(set) var current: TimeInterval?
+
+    private(set) var sampleCount: Int = 0
+
+    func record(_ timestamp: EchoTimestamp) {
+        record(latency: timestamp.liveEdgeTimestamp - timestamp.currentTimestamp)
+    }
+
+    func record(latency: TimeInterval) {
+        let latency = max(0, latency)
+        current = latency
+        sampleCount += 1
+        buckets[LiveEdgeLatencyTracker.bucket(for: latency)] += 1
+    }
+
+    func reset() {
+        for index in buckets.indices {
+            buckets[index] = 0
+        }
+        current = nil
+        sampleCount = 0
+    }
+
+    /**
+     The latency below which `fraction` of the samples fall, reported as the lower bound of its bucket,
+     so that a latency on a bucket boundary is reported exactly.
+     */
+    func percentile(_ fraction: Double) -> TimeInterval? {
+        guard sampleCount > 0 else {
+            return nil
+        }
+
+        let target = max(1, Int((Double(sampleCount) * fraction).rounded(.up)))
+        var seen = 0
+
+        for (index, count) in buckets.enumerated() {
+            seen += Int(count)
+            if seen >= target {
+                return LiveEdgeLatencyTracker.lowerBound(of: index)
+            }
+        }
+
+        return LiveEdgeLatencyTracker.lowerBound(of: buckets.count - 1)
+    }
+
+    /**
+     Current, p50 and p95 latency in milliseconds, for adding to heartbeat and end event labels.
+     */
+    func labels() -> [String: String] {
+        guard let current = current, let median = percentile(0.5), let p95 = percentile(0.95) else {
+            return [:]
+        }
+
+        return [EchoLiveLabelKeys.LiveEdgeLatency.rawValue: LiveEdgeLatencyTracker.milliseconds(current),
+                EchoLiveLabelKeys.LiveEdgeLatencyP50.rawValue: LiveEdgeLatencyTracker.milliseconds(median),
+                EchoLiveLabelKeys.LiveEdgeLatencyP95.rawValue: LiveEdgeLatencyTracker.milliseconds(p95)]
+    }
+
+    private static func bucket(for latency: TimeInterval) -> Int {
+        let fineLimit = fineBucketWidth * TimeInterval(fineBucketCount)
+
+        if latency < fineLimit {
+            return Int(latency / fineBucketWidth)
+        }
+
+        return fineBucketCount + min(coarseBucketCount - 1, Int((latency - fineLimit) / coarseBucketWidth))
+    }
+
+    private static func lowerBound(of bucket: Int) -> TimeInterval {
+        if bucket < fineBucketCount {
+            return TimeInterval(bucket) * fineBucketWidth
+        }
+
+        return fineBucketWidth * TimeInterval(fineBucketCount) + TimeInterval(bucket - fineBucketCount) * coarseBucketWidth
+    }
+
+    private static func milliseconds(_ seconds: TimeInterval) -> String {
+        return String(UInt64((seconds * 1000).rounded()))
+    }
+
+}
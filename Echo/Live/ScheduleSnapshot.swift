@@ -0,0 +1,301 @@
+//
+//  ScheduleSnapshot.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ A compact, read-only binary image of a parsed ESS schedule which can be memory mapped
+ and queried in place, without decoding the whole schedule up front.
+
+ Layout (all integers little endian):
+
+     header      magic "ESS1", version UInt16, reserved UInt16,
+                 broadcastCount UInt32, stringCount UInt32, serviceIDRef UInt32, reserved UInt32
+     broadcasts  broadcastCount fixed width records, sorted by start time:
+                 startTime Float64, endTime Float64,
+                 id, versionId, episodeId, episodeTitle, brandTitle (UInt32 string refs), padding UInt32
+     strings     stringCount + 1 UInt32 offsets, followed by the UTF-8 bytes they index
+
+ Identical strings (brand titles in particular) are stored once in the string table.
+ */
+internal final class ScheduleSnapshot: ScheduleProtocol {
+
+    static let magic: [UInt8] = Array("ESS1".utf8)
+    static let formatVersion: UInt16 = 1
+
+    static let headerSize = 24
+    static let recordSize = 40
+    static let noString = UInt32.max
+
+    private let data: Data
+    private let broadcastCount: Int
+    private let stringCount: Int
+    private let stringOffsetsStart: Int
+    private let stringBytesStart: Int
+    private var serviceID: String?
+
+    // Broadcasts read from this snapshot share its pool, which is released along with the snapshot
+    private let pool = BroadcastStringPool()
+
+    // Live playback queries the same broadcast every tick, so keep the last one materialised. Queries
+    // can come from the broker's timer as well as the main thread, hence the lock.
+    private let lastLock = NSLock()
+    private var last: (index: Int, broadcast: Broadcast)?
+
+    /**
+     Wraps snapshot bytes, typically mapped from disk. Returns nil if the data is not a valid snapshot.
+     */
+    init?(data: Data) {
+        guard data.count >= ScheduleSnapshot.headerSize,
+              Array(data.prefix(4)) == ScheduleSnapshot.magic,
+              data.readUInt16(at: 4) == ScheduleSnapshot.formatVersion else {
+            return nil
+        }
+
+        let broadcastCount = Int(data.readUInt32(at: 8))
+        let stringCount = Int(data.readUInt32(at: 12))
+        let stringOffsetsStart = ScheduleSnapshot.headerSize + broadcastCount * ScheduleSnapshot.recordSize
+        let stringBytesStart = stringOffsetsStart + (stringCount + 1) * 4
+
+        guard data.count >= stringBytesStart,
+              data.count == stringBytesStart + Int(data.readUInt32(at: stringBytesStart - 4)) else {
+            return nil
+        }
+
+        self.data = data
+        self.broadcastCount = broadcastCount
+        self.stringCount = stringCount
+        self.stringOffsetsStart = stringOffsetsStart
+        self.stringBytesStart = stringBytesStart
+
+        // serviceID can only be resolved once the string table offsets are known
+        self.serviceID = string(data.readUInt32(at: 16))
+    }
+
+    /**
+     Memory maps a snapshot file. Returns nil if the file is missing or invalid.
+     */
+    convenience init?(contentsOf url: URL) {
+        guard let data = try? Data(contentsOf: url, options: .alwaysMapped) else {
+            return nil
+        }
+        self.init(data: data)
+    }
+
+    var count: Int {
+        return broadcastCount
+    }
+
+    /**
+     The end time of the last broadcast in the snapshot, e.g. to decide whether a stored snapshot is stale.
+     */
+    var lastEndTime: TimeInterval? {
+        return broadcastCount > 0 ? endTime(at: broadcastCount - 1) : nil
+    }
+
+    func query(_ time: TimeInterval) -> Broadcast? {
+        // Binary search for the last broadcast starting at or before the requested time
+        var low = 0
+        var high = broadcastCount - 1
+        var found: Int?
+
+        while low <= high {
+            let mid = (low + high) / 2
+            if startTime(at: mid) <= time {
+                found = mid
+                low = mid + 1
+            } else {
+                high = mid - 1
+            }
+        }
+
+        guard let index = found, time < endTime(at: index) else {
+            return nil
+        }
+
+        return broadcast(at: index)
+    }
+
+    func hasData() -> Bool {
+        return broadcastCount > 0
+    }
+
+    func getError() -> (EssError, String)? {
+        return nil
+    }
+
+    func getServiceID() -> String? {
+        return serviceID
+    }
+
+    func broadcast(at index: Int) -> Broadcast {
+        lastLock.lock()
+        let cached = last
+        lastLock.unlock()
+        if let cached = cached, cached.index == index {
+            return cached.broadcast
+        }
+
+        let record = recordOffset(index)
+        let broadcast = Broadcast(startTime: startTime(at: index),
+                                  endTime: endTime(at: index),
+                                  episodeId: string(data.readUInt32(at: record + 24)) ?? "",
+                                  episodeTitle: string(data.readUInt32(at: record + 28)) ?? "",
+                                  id: string(data.readUInt32(at: record + 16)) ?? "",
+                                  versionId: string(data.readUInt32(at: record + 20)) ?? "",
+                                  brandTitle: string(data.readUInt32(at: record + 32)) ?? "",
+                                  pool: pool)
+        lastLock.lock()
+        last = (index, broadcast)
+        lastLock.unlock()
+        return broadcast
+    }
+
+    private func recordOffset(_ index: Int) -> Int {
+        return ScheduleSnapshot.headerSize + index * ScheduleSnapshot.recordSize
+    }
+
+    private func startTime(at index: Int) -> TimeInterval {
+        return Double(bitPattern: data.readUInt64(at: recordOffset(index)))
+    }
+
+    private func endTime(at index: Int) -> TimeInterval {
+        return Double(bitPattern: data.readUInt64(at: recordOffset(index) + 8))
+    }
+
+    private func string(_ ref: UInt32) -> String? {
+        guard ref != ScheduleSnapshot.noString, Int(ref) < stringCount else {
+            return nil
+        }
+
+        let start = Int(data.readUInt32(at: stringOffsetsStart + Int(ref) * 4))
+        let end = Int(data.readUInt32(at: stringOffsetsStart + Int(ref) * 4 + 4))
+
+        guard start <= end, stringBytesStart + end <= data.count else {
+            return nil
+        }
+
+        return String(decoding: data[(data.startIndex + stringBytesStart + start)..<(data.startIndex + stringBytesStart + end)],
+                      as: UTF8.self)
+    }
+
+    // MARK: - Encoding
+
+    /**
+     Serialises a schedule. Broadcasts are sorted by start time and their strings are interned.
+     */
+    static func encode(serviceID: String?, broadcasts: [Broadcast]) -> Data {
+        var strings = [String]()
+        var stringRefs = [String: UInt32]()
+
+        func intern(_ value: String?) -> UInt32 {
+            guard let value = value, !value.isEmpty else {
+                return noString
+            }
+            if let ref = stringRefs[value] {
+                return ref
+            }
+            let ref = UInt32(strings.count)
+            strings.append(value)
+            stringRefs[value] = ref
+            return ref
+        }
+
+        let sorted = broadcasts.sorted { $0.startTime < $1.startTime }
+        let serviceIDRef = intern(serviceID)
+
+        var data = Data(capacity: headerSize + sorted.count * recordSize)
+        data.append(contentsOf: magic)
+        data.appendLittleEndian(formatVersion)
+        data.appendLittleEndian(UInt16(0))
+        data.appendLittleEndian(UInt32(sorted.count))
+        let stringCountOffset = data.count
+        data.appendLittleEndian(UInt32(0))
+        data.appendLittleEndian(serviceIDRef)
+        data.appendLittleEndian(UInt32(0))
+
+        for broadcast in sorted {
+            data.appendLittleEndian(broadcast.startTime.bitPattern)
+            data.appendLittleEndian(broadcast.endTime.bitPattern)
+            data.appendLittleEndian(intern(broadcast.id))
+            data.appendLittleEndian(intern(broadcast.versionId))
+            data.appendLittleEndian(intern(broadcast.episodeId))
+            data.appendLittleEndian(intern(broadcast.episodeTitle))
+            data.appendLittleEndian(intern(broadcast.brandTitle))
+            data.appendLittleEndian(UInt32(0))
+        }
+
+        var blob = Data()
+        var offsets = [UInt32]()
+        for value in strings {
+            offsets.append(UInt32(blob.count))
+            blob.append(contentsOf: Array(value.utf8))
+        }
+        offsets.append(UInt32(blob.count))
+
+        for offset in offsets {
+            data.appendLittleEndian(offset)
+        }
+        data.append(blob)
+
+        data.replaceLittleEndian(UInt32(strings.count), at: stringCountOffset)
+
+        return data
+    }
+
+    /**
+     Builds a snapshot directly from an ESS schedule response. Returns nil if the response cannot be parsed.
+     */
+    static func encode(essResponse: Data) -> Data? {
+        guard let json = (try? JSONSerialization.jsonObject(with: essResponse, options: [])) as? [String: Any],
+              let items = json["items"] as? [[String: Any]] else {
+            return nil
+        }
+
+        let serviceID = (json["service"] as? [String: Any])?["id"] as? String
+
+        var broadcasts = [Broadcast]()
+        broadcasts.reserveCapacity(items.count)
+        let pool = BroadcastStringPool()
+
+        for item in items {
+            guard let publishedTime = item["published_time"] as? [String: Any],
+                  let start = (publishedTime["start"] as? String).flatMap(parseEssDate),
+                  let end = (publishedTime["end"] as? String).flatMap(parseEssDate) else {
+                continue
+            }
+
+            let episode = item["episode"] as? [String: Any]
+            let version = item["version"] as? [String: Any]
+            let brand = item["brand"] as? [String: Any]
+
+            broadcasts.append(Broadcast(startTime: start,
+                                        endTime: end,
+                                        episodeId: episode?["id"] as? String ?? "",
+                                        episodeTitle: episode?["title"] as? String ?? "",
+                                        id: item["id"] as? String ?? "",
+                                        versionId: version?["id"] as? String ?? "",
+                                        brandTitle: brand?["title"] as? String ?? "",
+                                        pool: pool))
+        }
+
+        return encode(serviceID: serviceID, broadcasts: broadcasts)
+    }
+
+    private static let essDateFormatter: DateFormatter = {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.timeZone = TimeZone(secondsFromGMT: 0)
+        formatter.dateFormat = "yyyy-MM-dd'T'HH:mm:ss.SSSZ"
+        return formatter
+    }()
+
+    private static func parseEssDate(_ value: String) -> TimeInterval? {
+        return essDateFormatter.date(from: value)?.timeIntervalSince1970
+    }
+
+}
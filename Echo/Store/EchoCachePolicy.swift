@@ -0,0 +1,97 @@
+//
+//  EchoCachePolicy.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Limits on the data Echo holds while events cannot be sent, such as downloads played offline.
+
+ `maxBytes` is the total budget for the event log. Once it is exceeded, records which have already
+ been delivered go first, then records are evicted according to `eviction`. With `keepStartAndEnd`,
+ play and end events are kept for as long as anything else can be evicted instead, so that sessions
+ can still be reconstructed. Queues owned by individual delegates are limited by `delegateQuotas`.
+ */
+internal struct EchoCachePolicy: Equatable {
+
+    enum Eviction: String {
+        /// Drop the oldest records first
+        case oldestFirst = "oldest_first"
+        /// Drop heartbeats, oldest first, before any other record
+        case heartbeatsFirst = "heartbeats_first"
+    }
+
+    static let defaultMaxBytes = 5 * 1024 * 1024
+    /// Smallest budget accepted, below which eviction would leave too little to be useful
+    static let minimumMaxBytes = 16 * 1024
+
+    var maxBytes: Int
+    var eviction: Eviction
+    var keepStartAndEnd: Bool
+    /// Byte quotas for delegate queues, keyed by delegate name, e.g. "collector"
+    var delegateQuotas: [String: Int]
+
+    init(maxBytes: Int = EchoCachePolicy.defaultMaxBytes, eviction: Eviction = .heartbeatsFirst,
+         keepStartAndEnd: Bool = true, delegateQuotas: [String: Int] = [:]) {
+        self.maxBytes = max(maxBytes, EchoCachePolicy.minimumMaxBytes)
+        self.eviction = eviction
+        self.keepStartAndEnd = keepStartAndEnd
+        self.delegateQuotas = delegateQuotas
+    }
+
+    /**
+     Builds a policy from the client's config. Returns nil when no budget is configured; values which
+     are present but invalid are logged and replaced with the defaults.
+     */
+    init?(config: [EchoConfigKey: String]) {
+        guard let rawMaxBytes = config[.echoCacheMaxBytes] else {
+            return nil
+        }
+
+        var maxBytes = EchoCachePolicy.defaultMaxBytes
+        if let value = Int(rawMaxBytes), value > 0 {
+            maxBytes = value
+        } else {
+            EchoDebug.log(level: .error, message: "Invalid \(EchoConfigKey.echoCacheMaxBytes.rawValue) '\(rawMaxBytes)', using default")
+        }
+
+        var eviction = Eviction.heartbeatsFirst
+        if let rawEviction = config[.echoCacheEviction] {
+            if let value = Eviction(rawValue: rawEviction) {
+                eviction = value
+            } else {
+                EchoDebug.log(level: .error, message: "Invalid \(EchoConfigKey.echoCacheEviction.rawValue) '\(rawEviction)', using default")
+            }
+        }
+
+        var quotas = [String: Int]()
+        for (key, value) in config where key.rawValue.hasPrefix(EchoConfigKey.echoCacheQuotaPrefix) {
+            guard let quota = Int(value), quota > 0 else {
+                EchoDebug.log(level: .error, message: "Invalid \(key.rawValue) '\(value)', ignoring")
+                continue
+            }
+            quotas[String(key.rawValue.dropFirst(EchoConfigKey.echoCacheQuotaPrefix.count))] = quota
+        }
+
+        self.init(maxBytes: maxBytes, eviction: eviction,
+                  keepStartAndEnd: config[.echoCacheKeepStartAndEnd] != "false",
+                  delegateQuotas: quotas)
+    }
+
+    func quota(for delegate: String) -> Int? {
+        return delegateQuotas[delegate]
+    }
+
+    /// Heartbeats are the least valuable records, as each is superseded by the next
+    static func isHeartbeat(_ record: EchoEventRecord) -> Bool {
+        return record.kind == .avUserAction && record.type == "echo_hb"
+    }
+
+    static func isStartOrEnd(_ record: EchoEventRecord) -> Bool {
+        return record.kind == .avPlay || record.kind == .avEnd
+    }
+
+}
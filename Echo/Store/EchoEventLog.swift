@@ -0,0 +1,806 @@
+//
+//  EchoEventLog.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Append-only log of dispatched events, independent of the offline caches kept by each vendor SDK.
+ `EchoClient` appends each event before handing it to its delegates, and marks it delivered once the
+ delegates acknowledge sending it, so anything else can be replayed to a delegate after a crash or an
+ offline period. Appending only numbers and frames the record; the file work is done in order on the
+ log's own queue.
+
+ The log is a directory of segment files, each named after the sequence number of its first record:
+
+     header   magic "EEL1", version UInt16, flags UInt16, firstSequence UInt64
+     records  payloadLength UInt32, crc UInt32 (over sequence and payload), sequence UInt64, payload
+
+ With the `compressed` flag set, payloads in that segment are deflated with `EchoCompressionDictionary.eventLog`,
+ whose version is held in the high byte of the flags. The flags are per segment, so a log can be reopened
+ with compression switched on or off, or by a version of Echo with a newer dictionary.
+
+ Persistent labels are written as `.labelSnapshot` records when they change and again at the start of
+ each segment, so every segment can be replayed on its own and events only carry a snapshot version.
+
+ On open every segment is scanned and each record's CRC is checked. A torn or corrupt tail, from a
+ crash part way through a write, is truncated away. The delivery cursor is kept in a separate file
+ and written in batches, so after a crash a few delivered events may be replayed again.
+
+ With `.groupCommit` durability, records are held briefly and written with one write and one fsync
+ per group, so a sync to disk is not paid per event. A group is committed `interval` seconds after its
+ first record, or sooner once `maxRecords` are waiting; `committedThrough` is the last record known to
+ be on disk. A crash loses at most the group being collected, and recovery discards a group left torn.
+
+ With an `EchoCachePolicy`, the log is kept within a byte budget. Closed segments are rewritten without
+ the records the policy evicts first, or removed outright, so sequence numbers in a segment may have gaps.
+ */
+internal final class EchoEventLog {
+
+    enum LogError: Error {
+        case cannotCreateDirectory(URL)
+    }
+
+    enum Durability {
+        /// Each record is written as it is appended, and synced at checkpoints
+        case checkpointed
+        /// Records are written and synced in groups
+        case groupCommit(interval: TimeInterval, maxRecords: Int)
+    }
+
+    static let magic: [UInt8] = Array("EEL1".utf8)
+    static let formatVersion: UInt16 = 1
+    static let segmentHeaderSize = 16
+    static let recordHeaderSize = 16
+    static let segmentExtension = "seg"
+    static let cursorFileName = "cursor"
+    static let compressedFlag: UInt16 = 1
+
+    private let directory: URL
+    private let segmentSize: Int
+    private let cursorPersistInterval: UInt64
+    private let compressRecords: Bool
+    private let durability: Durability
+    private let lock = NSLock()
+    /// Every file write, sync and removal runs here, in the order it was asked for, so appends never wait on the disk
+    private let queue = DispatchQueue(label: "uk.co.bbc.echo.eventlog")
+
+    private struct Segment {
+        let firstSequence: UInt64
+        let url: URL
+        var bytes: Int
+    }
+
+    // Guarded by `lock`
+    private let cachePolicy: EchoCachePolicy?
+    private var segments = [Segment]()
+    private var segmentOpen = false
+    private var currentSegmentCompressed = false
+    private var currentSegmentSnapshotVersion: UInt32 = 0
+    private var evictionScheduled = false
+
+    // Confined to `queue`
+    private var handle: FileHandle?
+    /// First sequence of the segment `handle` writes to; segments before it are closed on disk
+    private var handleFirstSequence: UInt64 = 0
+    private var writtenThrough: UInt64 = 0
+    private var pendingFrames = Data()
+    private var pendingCount = 0
+    private var pendingThrough: UInt64 = 0
+    private var commitScheduled = false
+
+    private(set) var lastSequence: UInt64 = 0
+    /// Last record synced to disk
+    private(set) var committedThrough: UInt64 = 0
+    private(set) var deliveredThrough: UInt64 = 0
+    private var persistedDeliveredThrough: UInt64 = 0
+    private var handedOverThrough: UInt64 = 0
+
+    /// Number of segments found with a torn or corrupt tail when the log was opened, and cut back to their valid records
+    private(set) var truncatedSegments = 0
+
+    /// Bytes cut from the tails of `truncatedSegments`, which may have held more than one record
+    private(set) var truncatedBytes = 0
+
+    /// Number of undelivered records evicted to keep within the cache policy's budget
+    private(set) var evictedRecords = 0
+
+    init(directory: URL = EchoEventLog.defaultDirectory(), segmentSize: Int = 1 << 20,
+         cursorPersistInterval: UInt64 = 64, compressRecords: Bool = false, cachePolicy: EchoCachePolicy? = nil,
+         durability: Durability = .checkpointed) throws {
+        self.directory = directory
+        self.durability = durability
+        // Eviction works a closed segment at a time, so segments must be small next to the budget
+        self.segmentSize = cachePolicy.map { min(segmentSize, $0.maxBytes / 4) } ?? segmentSize
+        self.cachePolicy = cachePolicy
+        self.cursorPersistInterval = cursorPersistInterval
+        self.compressRecords = compressRecords
+
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true, attributes: nil)
+        } catch {
+            throw LogError.cannotCreateDirectory(directory)
+        }
+
+        recover()
+        committedThrough = lastSequence
+        writtenThrough = lastSequence
+    }
+
+    deinit {
+        // Work on the queue holds the log, so none is left by now
+        writePending(sync: true)
+        handle?.closeFile()
+    }
+
+    static func defaultDirectory() -> URL {
+        let support = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask).first
+                ?? URL(fileURLWithPath: NSTemporaryDirectory())
+        return support.appendingPathComponent("echo_events", isDirectory: true)
+    }
+
+    /// Bytes across all segments, including records still queued to be written
+    var storedBytes: Int {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return totalBytes
+    }
+
+    private var totalBytes: Int {
+        return segments.reduce(0) { $0 + $1.bytes }
+    }
+
+    private var currentSegmentBytes: Int {
+        return segments.last?.bytes ?? 0
+    }
+
+    /**
+     Waits for the file work queued so far, including any eviction it sets off. For tests, which look
+     at the files themselves.
+     */
+    func drain() {
+        var evicting = false
+        repeat {
+            queue.sync {}
+            lock.lock()
+            evicting = evictionScheduled
+            lock.unlock()
+        } while evicting
+    }
+
+    // MARK: - Writing
+
+    /**
+     Appends a record and returns its sequence number, or nil if it could not be encoded. When `snapshot`
+     is given the record refers to its current version, and the labels are written first if this segment
+     does not already hold that version. The record is numbered and framed here; it is written on the
+     log's queue.
+     */
+    @discardableResult
+    func append(_ record: EchoEventRecord, snapshot: PersistentLabelSnapshot? = nil) -> UInt64? {
+        var record = record
+
+        lock.lock()
+        defer { lock.unlock() }
+
+        if !segmentOpen || currentSegmentBytes >= segmentSize || currentSegmentCompressed != compressRecords {
+            openSegment(firstSequence: lastSequence + 1)
+        }
+
+        if let snapshot = snapshot, snapshot.version > 0 {
+            if snapshot.version != currentSegmentSnapshotVersion {
+                guard write(EchoEventRecord.snapshot(snapshot).encoded()) != nil else {
+                    return nil
+                }
+                currentSegmentSnapshotVersion = snapshot.version
+            }
+            record.snapshotVersion = snapshot.version
+        }
+
+        let sequence = write(record.encoded())
+
+        if let policy = cachePolicy, totalBytes > policy.maxBytes, !evictionScheduled {
+            evictionScheduled = true
+            queue.async {
+                self.enforceBudget(policy)
+            }
+        }
+
+        return sequence
+    }
+
+    // Must be called with the lock held and a segment open
+    private func write(_ payload: Data) -> UInt64? {
+        var payload = payload
+        let sequence = lastSequence + 1
+
+        if currentSegmentCompressed {
+            guard let compressed = EchoCompressionDictionary.eventLog.compress(payload) else {
+                return nil
+            }
+            payload = compressed
+        }
+
+        let frame = EchoEventLog.frame(payload, sequence: sequence)
+        queue.async {
+            self.writeFrame(frame, sequence: sequence)
+        }
+
+        segments[segments.count - 1].bytes += frame.count
+        lastSequence = sequence
+
+        return sequence
+    }
+
+    // Confined to `queue`
+    private func writeFrame(_ frame: Data, sequence: UInt64) {
+        switch durability {
+        case .checkpointed:
+            handle?.write(frame)
+            writtenThrough = sequence
+        case .groupCommit(let interval, let maxRecords):
+            pendingFrames.append(frame)
+            pendingCount += 1
+            pendingThrough = sequence
+
+            if pendingCount >= maxRecords {
+                writePending(sync: true)
+            } else if !commitScheduled {
+                commitScheduled = true
+                queue.asyncAfter(deadline: .now() + interval) { [weak self] in
+                    self?.commitScheduled = false
+                    self?.writePending(sync: true)
+                }
+            }
+        }
+    }
+
+    // Confined to `queue`
+    private func writePending(sync: Bool) {
+        if !pendingFrames.isEmpty {
+            handle?.write(pendingFrames)
+            pendingFrames.removeAll(keepingCapacity: true)
+            pendingCount = 0
+            writtenThrough = pendingThrough
+        }
+
+        if sync {
+            handle?.synchronizeFile()
+            lock.lock()
+            committedThrough = max(committedThrough, writtenThrough)
+            lock.unlock()
+        }
+    }
+
+    /**
+     Commits any records waiting for their group, without waiting for the group to fill or its interval to pass.
+     Waits for the records appended so far to be written and synced.
+     */
+    func commit() {
+        queue.sync {
+            writePending(sync: true)
+        }
+    }
+
+    private static func frame(_ payload: Data, sequence: UInt64) -> Data {
+        var sequenceBytes = Data()
+        sequenceBytes.appendLittleEndian(sequence)
+
+        var frame = Data(capacity: recordHeaderSize + payload.count)
+        frame.appendLittleEndian(UInt32(payload.count))
+        frame.appendLittleEndian(CRC32.checksum(payload, seed: CRC32.checksum(sequenceBytes)))
+        frame.append(sequenceBytes)
+        frame.append(payload)
+        return frame
+    }
+
+    /**
+     Records that every event up to and including `sequence` has been handed to the delegates, which
+     have yet to acknowledge sending them.
+     */
+    func markDispatched(through sequence: UInt64) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        handedOverThrough = max(handedOverThrough, min(sequence, lastSequence))
+    }
+
+    /// Last event handed to the delegates, which a flush started now covers
+    var dispatchedThrough: UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return max(handedOverThrough, deliveredThrough)
+    }
+
+    /**
+     Records that every event up to and including `sequence` has been acknowledged by the delegates.
+     */
+    func markDelivered(through sequence: UInt64) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        deliveredThrough = max(deliveredThrough, min(sequence, lastSequence))
+
+        if deliveredThrough - persistedDeliveredThrough >= cursorPersistInterval {
+            persistCursor()
+        }
+    }
+
+    /**
+     Writes the delivery cursor, removes segments which have been fully delivered and flushes to disk.
+     Called when the app is backgrounded or the cache is flushed, so it waits for the writes to finish
+     before the app can be suspended.
+     */
+    func checkpoint() {
+        lock.lock()
+        persistCursor()
+        lock.unlock()
+
+        commit()
+    }
+
+    func clear() {
+        lock.lock()
+        defer { lock.unlock() }
+
+        let urls = segments.map { $0.url }
+        segments.removeAll()
+        segmentOpen = false
+
+        queue.async {
+            self.pendingFrames.removeAll()
+            self.pendingCount = 0
+            self.handle?.closeFile()
+            self.handle = nil
+            for url in urls {
+                try? FileManager.default.removeItem(at: url)
+            }
+        }
+
+        deliveredThrough = lastSequence
+        persistCursor()
+    }
+
+    // MARK: - Reading
+
+    /**
+     Calls `body` with each event record after `sequence`, in order. With `includeSnapshots`, label
+     snapshot records are passed too, including those at or before `sequence` in the first segment read,
+     so that the labels for every event passed are known.
+     */
+    func forEachRecord(after sequence: UInt64, includeSnapshots: Bool = false, _ body: (UInt64, EchoEventRecord) -> Void) {
+        queue.sync {
+            writePending(sync: false)
+        }
+
+        lock.lock()
+        let segments = self.segments
+        let lastSequence = self.lastSequence
+        lock.unlock()
+
+        for (index, segment) in segments.enumerated() {
+            if index + 1 < segments.count && segments[index + 1].firstSequence <= sequence + 1 {
+                continue
+            }
+
+            guard let data = try? Data(contentsOf: segment.url, options: .alwaysMapped) else {
+                continue
+            }
+
+            let decode = EchoEventLog.payloadDecoder(data)
+
+            _ = EchoEventLog.scan(data) { recordSequence, payload in
+                guard recordSequence <= lastSequence,
+                      let payload = decode(payload),
+                      let record = EchoEventRecord(encoded: payload) else {
+                    return
+                }
+
+                if record.kind == .labelSnapshot ? includeSnapshots : recordSequence > sequence {
+                    body(recordSequence, record)
+                }
+            }
+        }
+    }
+
+    /**
+     Replays every record up to `through` not yet marked as delivered to `delegates`, then marks them
+     dispatched; they are marked delivered once the delegates acknowledge them.
+     Before each event the delegates' persistent labels are brought to the snapshot that event was
+     logged with. Returns the last snapshot applied, so the caller can restore its current labels.
+     */
+    @discardableResult
+    func replayUndelivered(to delegates: [EchoDelegate], through: UInt64 = UInt64.max) -> [String: String] {
+        var replayed: UInt64?
+        // Versions restart with each run of the app, so snapshots are told apart by their own sequence
+        var snapshots = [UInt32: (sequence: UInt64, labels: [String: String])]()
+        var appliedSnapshot: UInt64?
+        var appliedLabels = [String: String]()
+
+        forEachRecord(after: deliveredThrough, includeSnapshots: true) { sequence, record in
+            guard sequence <= through else {
+                return
+            }
+
+            if record.kind == .labelSnapshot {
+                snapshots[record.snapshotVersion] = (sequence, record.labels ?? [:])
+                return
+            }
+
+            if let snapshot = snapshots[record.snapshotVersion], snapshot.sequence != appliedSnapshot {
+                PersistentLabelSnapshot.apply(snapshot.labels, replacing: appliedLabels, to: delegates)
+                appliedSnapshot = snapshot.sequence
+                appliedLabels = snapshot.labels
+            }
+
+            for delegate in delegates {
+                record.replay(to: delegate)
+            }
+            replayed = sequence
+        }
+
+        if let replayed = replayed {
+            markDispatched(through: replayed)
+        }
+
+        return appliedLabels
+    }
+
+    // MARK: - Recovery
+
+    private func recover() {
+        let files = (try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil,
+                                                                  options: [])) ?? []
+
+        segments = files.compactMap { url -> Segment? in
+            guard url.pathExtension == EchoEventLog.segmentExtension,
+                  let firstSequence = UInt64(url.deletingPathExtension().lastPathComponent, radix: 16) else {
+                return nil
+            }
+            return Segment(firstSequence: firstSequence, url: url, bytes: 0)
+        }.sorted { $0.firstSequence < $1.firstSequence }
+
+        var unreadable = Set<URL>()
+
+        for (index, segment) in segments.enumerated() {
+            guard let data = try? Data(contentsOf: segment.url, options: .alwaysMapped),
+                  data.count >= EchoEventLog.segmentHeaderSize, Array(data.prefix(4)) == EchoEventLog.magic else {
+                unreadable.insert(segment.url)
+                continue
+            }
+
+            let isLast = index == segments.count - 1
+            var expected = max(lastSequence + 1, segment.firstSequence)
+
+            // Sequences only increase, but eviction may have left gaps
+            let validLength = EchoEventLog.scan(data) { sequence, _ in
+                if sequence >= expected {
+                    lastSequence = sequence
+                    expected = sequence + 1
+                }
+            }
+            segments[index].bytes = validLength
+
+            if validLength < data.count {
+                truncatedSegments += 1
+                truncatedBytes += data.count - validLength
+                EchoDebug.log(level: .warn, message: "Discarding \(data.count - validLength) corrupt bytes from event log segment \(segment.url.lastPathComponent)")
+
+                if let handle = try? FileHandle(forWritingTo: segment.url) {
+                    handle.truncateFile(atOffset: UInt64(validLength))
+                    handle.closeFile()
+                }
+            }
+
+            // Appending carries on in the last segment unless it was deflated with another dictionary
+            let flags = EchoEventLog.flags(data)
+            if isLast && validLength >= EchoEventLog.segmentHeaderSize
+                       && (flags == EchoEventLog.segmentFlags(compressed: true) || flags == EchoEventLog.segmentFlags(compressed: false)) {
+                handle = try? FileHandle(forWritingTo: segment.url)
+                handle?.seekToEndOfFile()
+                handleFirstSequence = segment.firstSequence
+                segmentOpen = handle != nil
+                currentSegmentCompressed = flags != 0
+            }
+        }
+
+        for url in unreadable {
+            EchoDebug.log(level: .warn, message: "Removing unreadable event log segment \(url.lastPathComponent)")
+            try? FileManager.default.removeItem(at: url)
+        }
+        segments = segments.filter { !unreadable.contains($0.url) }
+
+        if let cursor = try? Data(contentsOf: directory.appendingPathComponent(EchoEventLog.cursorFileName)),
+           let delivered = cursor.readLittleEndian(UInt64.self, at: 0),
+           let crc = cursor.readLittleEndian(UInt32.self, at: 8),
+           crc == CRC32.checksum(cursor.prefix(8)) {
+            deliveredThrough = min(delivered, lastSequence)
+            persistedDeliveredThrough = deliveredThrough
+        }
+    }
+
+    private static func flags(_ data: Data) -> UInt16 {
+        return data.readLittleEndian(UInt16.self, at: 6) ?? 0
+    }
+
+    private static func segmentFlags(compressed: Bool) -> UInt16 {
+        return compressed ? compressedFlag | UInt16(EchoCompressionDictionary.eventLog.version) << 8 : 0
+    }
+
+    /**
+     How the payloads in a segment are read, going by its flags. Payloads deflated with a dictionary this
+     version of Echo does not have cannot be read.
+     */
+    private static func payloadDecoder(_ data: Data) -> (Data) -> Data? {
+        let flags = self.flags(data)
+        guard flags & compressedFlag != 0 else {
+            return { $0 }
+        }
+        guard let dictionary = EchoCompressionDictionary.eventLogDictionary(version: Int(flags >> 8)) else {
+            return { _ in nil }
+        }
+        return dictionary.decompress
+    }
+
+    /**
+     Walks the records in a segment, returning the length of the valid prefix.
+     */
+    private static func scan(_ data: Data, _ body: (UInt64, Data) -> Void) -> Int {
+        guard data.count >= segmentHeaderSize, Array(data.prefix(4)) == magic,
+              data.readLittleEndian(UInt16.self, at: 4) == formatVersion else {
+            return 0
+        }
+
+        var offset = segmentHeaderSize
+
+        while offset + recordHeaderSize <= data.count {
+            guard let length = data.readLittleEndian(UInt32.self, at: offset),
+                  let crc = data.readLittleEndian(UInt32.self, at: offset + 4),
+                  offset + recordHeaderSize + Int(length) <= data.count else {
+                break
+            }
+
+            let sequenceRange = (data.startIndex + offset + 8)..<(data.startIndex + offset + recordHeaderSize)
+            let payloadRange = sequenceRange.upperBound..<(sequenceRange.upperBound + Int(length))
+
+            let computed = data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> UInt32 in
+                let base = data.startIndex
+                let sequenceCRC = CRC32.checksum(UnsafeRawBufferPointer(rebasing: buffer[(sequenceRange.lowerBound - base)..<(sequenceRange.upperBound - base)]))
+                return CRC32.checksum(UnsafeRawBufferPointer(rebasing: buffer[(payloadRange.lowerBound - base)..<(payloadRange.upperBound - base)]),
+                                      seed: sequenceCRC)
+            }
+
+            guard computed == crc, let sequence = data.readLittleEndian(UInt64.self, at: offset + 8) else {
+                break
+            }
+
+            body(sequence, data.subdata(in: payloadRange))
+            offset = payloadRange.upperBound - data.startIndex
+        }
+
+        return offset
+    }
+
+    // MARK: - Files
+
+    // Must be called with the lock held
+    private func openSegment(firstSequence: UInt64) {
+        let url = directory.appendingPathComponent(String(format: "%016llx", firstSequence))
+                .appendingPathExtension(EchoEventLog.segmentExtension)
+
+        var header = Data(EchoEventLog.magic)
+        header.appendLittleEndian(EchoEventLog.formatVersion)
+        header.appendLittleEndian(EchoEventLog.segmentFlags(compressed: compressRecords))
+        header.appendLittleEndian(firstSequence)
+
+        queue.async {
+            self.writePending(sync: true)
+            self.handle?.closeFile()
+            self.handle = nil
+
+            guard FileManager.default.createFile(atPath: url.path, contents: header, attributes: nil),
+                  let handle = try? FileHandle(forWritingTo: url) else {
+                EchoDebug.log(level: .error, message: "Unable to open event log segment \(url.lastPathComponent)")
+                return
+            }
+
+            handle.seekToEndOfFile()
+            self.handle = handle
+            self.handleFirstSequence = firstSequence
+        }
+
+        segmentOpen = true
+        currentSegmentCompressed = compressRecords
+        currentSegmentSnapshotVersion = 0
+
+        // An empty segment starting at the same sequence is being replaced
+        if segments.last?.firstSequence == firstSequence {
+            segments.removeLast()
+        }
+        segments.append(Segment(firstSequence: firstSequence, url: url, bytes: header.count))
+    }
+
+    /**
+     Drops fully delivered segments and queues the cursor to be written, then the segments removed. If the
+     cursor cannot be written the segments are left on disk, to be found and replayed again on next open.
+     Must be called with the lock held.
+     */
+    private func persistCursor() {
+        var cursor = Data()
+        cursor.appendLittleEndian(deliveredThrough)
+        cursor.appendLittleEndian(CRC32.checksum(cursor))
+        persistedDeliveredThrough = deliveredThrough
+
+        // A segment is fully delivered once the segment after it starts at or before the cursor
+        var delivered = [URL]()
+        while segments.count > 1 && segments[1].firstSequence <= deliveredThrough + 1 {
+            delivered.append(segments.removeFirst().url)
+        }
+
+        let url = directory.appendingPathComponent(EchoEventLog.cursorFileName)
+        queue.async {
+            do {
+                try cursor.write(to: url, options: .atomic)
+            } catch {
+                EchoDebug.log(level: .error, message: "Unable to write event log cursor: \(error)")
+                return
+            }
+
+            for segment in delivered {
+                try? FileManager.default.removeItem(at: segment)
+            }
+        }
+    }
+
+    // MARK: - Eviction
+
+    /**
+     Brings the log back under its budget, evicting in passes: delivered records, heartbeats if the policy says so,
+     then anything but play and end events if they are kept, then whole segments. Each pass works from
+     the oldest segment closed on disk; the open segment is left alone. Eviction carries on to 90% of the
+     budget so that it does not run again on the very next append. Runs on the log's queue, taking the lock
+     only to read and update the segment list, so appends carry on while segments are rewritten.
+     */
+    private func enforceBudget(_ policy: EchoCachePolicy) {
+        lock.lock()
+        if deliveredThrough > persistedDeliveredThrough {
+            persistCursor()
+        }
+        let delivered = deliveredThrough
+        let hasDelivered = segments.first.map { delivered >= $0.firstSequence } ?? false
+        let evictedBefore = evictedRecords
+        lock.unlock()
+
+        let target = policy.maxBytes / 10 * 9
+        var passes = [(EchoEventRecord) -> Bool]()
+
+        // Delivered records are always dropped, so a pass evicting nothing else clears those alone
+        if hasDelivered {
+            passes.append { _ in false }
+        }
+        if policy.eviction == .heartbeatsFirst {
+            passes.append(EchoCachePolicy.isHeartbeat)
+        }
+        if policy.keepStartAndEnd {
+            passes.append { !EchoCachePolicy.isStartOrEnd($0) }
+        }
+        passes.append { _ in true }
+
+        for evictable in passes {
+            var index = 0
+            while true {
+                lock.lock()
+                guard totalBytes > target, index < segments.count,
+                      segments[index].firstSequence < handleFirstSequence else {
+                    lock.unlock()
+                    break
+                }
+                let segment = segments[index]
+                lock.unlock()
+
+                if compact(segment, deliveredThrough: delivered, evicting: evictable) {
+                    index += 1
+                }
+            }
+        }
+
+        lock.lock()
+        let evicted = evictedRecords - evictedBefore
+        // Segments closed since this pass was queued are still being written; go again once they are
+        let again = totalBytes > target && segments.dropLast().contains { $0.firstSequence >= handleFirstSequence }
+        evictionScheduled = again
+        lock.unlock()
+
+        if evicted > 0 {
+            EchoDebug.log(level: .warn, message: "Event log over its \(policy.maxBytes) byte budget, evicted \(evicted) records")
+        }
+        if again {
+            queue.async {
+                self.enforceBudget(policy)
+            }
+        }
+    }
+
+    /**
+     Rewrites a closed segment without delivered records or those matching `evictable`, removing it if
+     no events are left. Each remaining event keeps the latest label snapshot before it. Returns false
+     if the segment was removed. Runs on the log's queue.
+     */
+    private func compact(_ segment: Segment, deliveredThrough: UInt64, evicting evictable: (EchoEventRecord) -> Bool) -> Bool {
+        guard let data = try? Data(contentsOf: segment.url) else {
+            try? FileManager.default.removeItem(at: segment.url)
+            removeSegment(segment.url)
+            return false
+        }
+
+        let decode = EchoEventLog.payloadDecoder(data)
+        var kept = Data(data.prefix(EchoEventLog.segmentHeaderSize))
+        var keptEvents = 0
+        var evicted = 0
+        var snapshotFrame: Data?
+
+        _ = EchoEventLog.scan(data) { sequence, payload in
+            guard let decoded = decode(payload),
+                  let record = EchoEventRecord(encoded: decoded) else {
+                return
+            }
+
+            if record.kind == .labelSnapshot {
+                snapshotFrame = EchoEventLog.frame(payload, sequence: sequence)
+                return
+            }
+
+            guard sequence > deliveredThrough else {
+                return
+            }
+
+            if evictable(record) {
+                evicted += 1
+                return
+            }
+
+            if let frame = snapshotFrame {
+                kept.append(frame)
+                snapshotFrame = nil
+            }
+            kept.append(EchoEventLog.frame(payload, sequence: sequence))
+            keptEvents += 1
+        }
+
+        lock.lock()
+        evictedRecords += evicted
+        lock.unlock()
+
+        guard keptEvents > 0 else {
+            try? FileManager.default.removeItem(at: segment.url)
+            removeSegment(segment.url)
+            return false
+        }
+
+        if kept.count < data.count {
+            do {
+                try kept.write(to: segment.url, options: .atomic)
+                lock.lock()
+                if let index = segments.firstIndex(where: { $0.url == segment.url }) {
+                    segments[index].bytes = kept.count
+                }
+                lock.unlock()
+            } catch {
+                EchoDebug.log(level: .error, message: "Unable to rewrite event log segment \(segment.url.lastPathComponent): \(error)")
+            }
+        }
+        return true
+    }
+
+    private func removeSegment(_ url: URL) {
+        lock.lock()
+        segments.removeAll { $0.url == url }
+        lock.unlock()
+    }
+
+}
@@ -0,0 +1,152 @@
+//
+//  EchoEventRecord.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ An event as dispatched by `EchoClient`, after label sanitisation and position correction,
+ in a form that can be written to the event log and replayed to any `EchoDelegate`.
+
+ Persistent labels are not repeated in each event. Instead `snapshotVersion` refers to a
+ `.labelSnapshot` record written earlier in the log, which holds the full set of persistent labels.
+ */
+internal struct EchoEventRecord: Equatable {
+
+    enum Kind: UInt8 {
+        case view = 1
+        case userAction
+        case error
+        case avPlay
+        case avPause
+        case avBuffer
+        case avEnd
+        case avRewind
+        case avFastForward
+        case avSeek
+        case avUserAction
+        /// Persistent labels as of version `snapshotVersion`, held in `labels`
+        case labelSnapshot
+    }
+
+    let kind: Kind
+    let timestamp: TimeInterval
+    /// Counter name, action name or error, depending on `kind`
+    let name: String
+    /// Action type for user action events
+    let type: String
+    let position: UInt64
+    let rate: UInt64
+    let labels: [String: String]?
+    /// Version of the persistent labels in effect for this event, or 0 if none were recorded
+    var snapshotVersion: UInt32 = 0
+
+    init(kind: Kind, timestamp: TimeInterval = Date().timeIntervalSince1970, name: String = "", type: String = "",
+         position: UInt64 = 0, rate: UInt64 = 0, labels: [String: String]?) {
+        self.kind = kind
+        self.timestamp = timestamp
+        self.name = name
+        self.type = type
+        self.position = position
+        self.rate = rate
+        self.labels = labels
+    }
+
+    private static let noLabels = UInt32.max
+
+    func encoded() -> Data {
+        var data = Data()
+        data.append(kind.rawValue)
+        data.appendLittleEndian(timestamp.bitPattern)
+        data.appendLittleEndian(position)
+        data.appendLittleEndian(rate)
+        data.appendLengthPrefixed(name)
+        data.appendLengthPrefixed(type)
+
+        if let labels = labels {
+            data.appendLittleEndian(UInt32(labels.count))
+            for (key, value) in labels {
+                data.appendLengthPrefixed(key)
+                data.appendLengthPrefixed(value)
+            }
+        } else {
+            data.appendLittleEndian(EchoEventRecord.noLabels)
+        }
+
+        data.appendLittleEndian(snapshotVersion)
+
+        return data
+    }
+
+    init?(encoded data: Data) {
+        var reader = ByteReader(data)
+
+        guard let rawKind = reader.read(UInt8.self), let kind = Kind(rawValue: rawKind),
+              let timestamp = reader.read(UInt64.self),
+              let position = reader.read(UInt64.self),
+              let rate = reader.read(UInt64.self),
+              let name = reader.readLengthPrefixedString(),
+              let type = reader.readLengthPrefixedString(),
+              let labelCount = reader.read(UInt32.self) else {
+            return nil
+        }
+
+        var labels: [String: String]?
+
+        if labelCount != EchoEventRecord.noLabels {
+            var decoded = [String: String](minimumCapacity: Int(labelCount))
+            for _ in 0..<labelCount {
+                guard let key = reader.readLengthPrefixedString(), let value = reader.readLengthPrefixedString() else {
+                    return nil
+                }
+                decoded[key] = value
+            }
+            labels = decoded
+        }
+
+        self.init(kind: kind, timestamp: TimeInterval(bitPattern: timestamp), name: name, type: type,
+                  position: position, rate: rate, labels: labels)
+
+        // Absent from records written before persistent labels were snapshotted
+        snapshotVersion = reader.read(UInt32.self) ?? 0
+    }
+
+    static func snapshot(_ snapshot: PersistentLabelSnapshot) -> EchoEventRecord {
+        var record = EchoEventRecord(kind: .labelSnapshot, labels: snapshot.labels)
+        record.snapshotVersion = snapshot.version
+        return record
+    }
+
+    func replay(to delegate: EchoDelegate) {
+        switch kind {
+        case .view:
+            delegate.viewEvent(counterName: name, eventLabels: labels)
+        case .userAction:
+            delegate.userActionEvent(actionType: type, actionName: name, eventLabels: labels)
+        case .error:
+            delegate.errorEvent(name, eventLabels: labels)
+        case .avPlay:
+            delegate.avPlayEvent(at: position, eventLabels: labels)
+        case .avPause:
+            delegate.avPauseEvent(at: position, eventLabels: labels)
+        case .avBuffer:
+            delegate.avBufferEvent(at: position, eventLabels: labels)
+        case .avEnd:
+            delegate.avEndEvent(at: position, eventLabels: labels)
+        case .avRewind:
+            delegate.avRewindEvent(at: position, rate: rate, eventLabels: labels)
+        case .avFastForward:
+            delegate.avFastForwardEvent(at: position, rate: rate, eventLabels: labels)
+        case .avSeek:
+            delegate.avSeekEvent(at: position, eventLabels: labels)
+        case .avUserAction:
+            delegate.avUserActionEvent(actionType: type, actionName: name, position: position, eventLabels: labels)
+        case .labelSnapshot:
+            break
+        }
+    }
+
+}
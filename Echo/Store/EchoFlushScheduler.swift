@@ -0,0 +1,363 @@
+//
+//  EchoFlushScheduler.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import UIKit
+
+internal enum EchoFlushOutcome {
+    /// Everything queued was accepted, totalling `bytes`
+    case sent(bytes: Int)
+    case failed
+    /// Handed to a delegate which flushes its own cache and does not report back
+    case handedOff
+}
+
+/**
+ Something which holds events and can be asked to send them, reporting back once it has.
+ */
+internal protocol EchoFlushTarget: class {
+
+    func flush(completion: @escaping (EchoFlushOutcome) -> Void)
+
+}
+
+/**
+ Adapts a delegate which only offers `flushCache()`, such as the vendor SDK delegates.
+ */
+internal final class EchoDelegateFlushTarget: EchoFlushTarget {
+
+    private let delegate: EchoDelegate
+
+    init(_ delegate: EchoDelegate) {
+        self.delegate = delegate
+    }
+
+    /// The vendor SDKs expect to be called on the main thread, as they are by `EchoClient`
+    func flush(completion: @escaping (EchoFlushOutcome) -> Void) {
+        DispatchQueue.main.async {
+            self.delegate.flushCache()
+            completion(.handedOff)
+        }
+    }
+
+}
+
+/**
+ Lets work carry on for a while once the app has moved to the background.
+ */
+internal protocol BackgroundTaskSource: class {
+
+    func begin(_ name: String, expiration: @escaping () -> Void) -> UIBackgroundTaskIdentifier
+
+    func end(_ task: UIBackgroundTaskIdentifier)
+
+}
+
+internal final class SystemBackgroundTasks: BackgroundTaskSource {
+
+    func begin(_ name: String, expiration: @escaping () -> Void) -> UIBackgroundTaskIdentifier {
+        return UIApplication.shared.beginBackgroundTask(withName: name, expirationHandler: expiration)
+    }
+
+    func end(_ task: UIBackgroundTaskIdentifier) {
+        UIApplication.shared.endBackgroundTask(task)
+    }
+
+}
+
+/**
+ Flushes its targets automatically instead of relying on `flushCache()` being called.
+
+ Flushes happen in windows aligned to multiples of `window` on the wall clock, with some leeway, so that
+ sends are grouped into as few radio wake-ups as possible and the system can coalesce the timer with
+ others. While offline no flushes are attempted; when connectivity returns the radio is already up, so
+ the targets are flushed straight away. Each consecutive failure doubles the delay before the next
+ window, up to `maxBackoff`. `flushWithinBudget` is for backgrounding: it flushes at once under a
+ background task and reports back within the budget whether or not the flush has finished.
+ */
+internal final class EchoFlushScheduler {
+
+    struct Configuration {
+        var window: TimeInterval = 60
+        /// Fraction of the window the timer may be deferred by to coalesce with other wake-ups
+        var leeway = 0.1
+        var maxBackoff: TimeInterval = 30 * 60
+        var backgroundBudget: TimeInterval = 5
+
+        init() {
+        }
+    }
+
+    struct Statistics {
+        var attempts = 0
+        var successes = 0
+        var failures = 0
+        /// Windows passed over, or background flushes not tried, because there was no connectivity
+        var skippedOffline = 0
+        /// Background flushes still running when their budget ran out
+        var timedOut = 0
+        var bytes = 0
+        var totalLatency: TimeInterval = 0
+        var lastLatency: TimeInterval = 0
+
+        var averageLatency: TimeInterval {
+            let completed = successes + failures
+            return completed > 0 ? totalLatency / TimeInterval(completed) : 0
+        }
+    }
+
+    private let targets: [EchoFlushTarget]
+    private let reachability: ReachabilitySource
+    private let configuration: Configuration
+    private let clock: TimeProtocol
+    private let queue: DispatchQueue
+    private let backgroundTasks: BackgroundTaskSource
+
+    private var timer: DispatchSourceTimer?
+    private var running = false
+    private var flushing = false
+    private var consecutiveFailures = 0
+    /// Completions for the next flush to start
+    private var flushCompletions = [() -> Void]()
+    /// Whether another flush is to start once the one under way finishes
+    private var followUpQueued = false
+    private var stats = Statistics()
+
+    /**
+     Called on the scheduler's queue as each flush starts. The closure it returns is called once the flush
+     finishes, with whether every target sent or handed off what it held, e.g. to mark events delivered.
+     */
+    var acknowledge: (() -> (_ succeeded: Bool) -> Void)?
+
+    init(targets: [EchoFlushTarget], reachability: ReachabilitySource, configuration: Configuration = Configuration(),
+         clock: TimeProtocol = SystemClock(), queue: DispatchQueue = DispatchQueue(label: "uk.co.bbc.echo.flush"),
+         backgroundTasks: BackgroundTaskSource = SystemBackgroundTasks()) {
+        self.targets = targets
+        self.reachability = reachability
+        self.configuration = configuration
+        self.clock = clock
+        self.queue = queue
+        self.backgroundTasks = backgroundTasks
+
+        reachability.reachabilityChanged = { [weak self] reachable in
+            self?.queue.async {
+                self?.reachabilityChanged(reachable)
+            }
+        }
+    }
+
+    deinit {
+        timer?.cancel()
+    }
+
+    var statistics: Statistics {
+        return queue.sync { stats }
+    }
+
+    func start() {
+        queue.async {
+            guard !self.running else {
+                return
+            }
+            self.running = true
+            self.scheduleNextWindow()
+        }
+    }
+
+    func stop() {
+        queue.async {
+            self.running = false
+            self.cancelTimer()
+        }
+    }
+
+    /**
+     Flushes now, calling `completion` once the flush finishes or `budget` seconds have passed,
+     whichever is first. A background task is held until then, or until the system expires it. The
+     flush carries on past the budget, but is no longer waited for. A flush already under way is
+     followed by another, so that everything dispatched by now is covered.
+     */
+    func flushWithinBudget(_ budget: TimeInterval? = nil, completion: (() -> Void)? = nil) {
+        let budget = budget ?? configuration.backgroundBudget
+
+        // Confined to queue once the flush below is enqueued
+        var task = UIBackgroundTaskIdentifier.invalid
+        let endTask = {
+            if task != .invalid {
+                self.backgroundTasks.end(task)
+                task = .invalid
+            }
+        }
+        task = backgroundTasks.begin("uk.co.bbc.echo.flush") {
+            self.queue.async(execute: endTask)
+        }
+
+        queue.async {
+            guard self.reachability.isReachable else {
+                self.stats.skippedOffline += 1
+                endTask()
+                completion?()
+                return
+            }
+
+            var finished = false
+            let finish = {
+                if !finished {
+                    finished = true
+                    endTask()
+                    completion?()
+                }
+            }
+
+            self.queue.asyncAfter(deadline: .now() + budget) {
+                if !finished {
+                    self.stats.timedOut += 1
+                    EchoDebug.log(level: .warn, message: "Flush did not finish within its \(budget)s budget")
+                    finish()
+                }
+            }
+
+            self.flush(then: finish)
+        }
+    }
+
+    // MARK: - Queue confined
+
+    private func reachabilityChanged(_ reachable: Bool) {
+        guard running else {
+            return
+        }
+
+        if reachable {
+            consecutiveFailures = 0
+            flush()
+        } else {
+            // Nothing to do until connectivity returns, so avoid waking up for each window
+            cancelTimer()
+        }
+    }
+
+    private func scheduleNextWindow() {
+        cancelTimer()
+
+        guard running else {
+            return
+        }
+
+        let backoff = min(configuration.maxBackoff, configuration.window * pow(2, Double(consecutiveFailures)))
+        let now = clock.currentTime()
+        let nextWindow = ((now + backoff) / configuration.window).rounded(.up) * configuration.window
+        let delay = max(0, nextWindow - now)
+
+        let timer = DispatchSource.makeTimerSource(queue: queue)
+        timer.schedule(deadline: .now() + delay,
+                       leeway: .milliseconds(Int(configuration.window * configuration.leeway * 1000)))
+        timer.setEventHandler { [weak self] in
+            self?.windowOpened()
+        }
+        timer.resume()
+        self.timer = timer
+    }
+
+    private func cancelTimer() {
+        timer?.cancel()
+        timer = nil
+    }
+
+    private func windowOpened() {
+        timer = nil
+
+        guard reachability.isReachable else {
+            // Keep checking in case connectivity returns without reachability reporting it
+            stats.skippedOffline += 1
+            scheduleNextWindow()
+            return
+        }
+
+        flush()
+    }
+
+    private func flush(then completion: (() -> Void)? = nil) {
+        if let completion = completion {
+            flushCompletions.append(completion)
+        }
+
+        // A flush already under way may have started before what the caller wants sent, so another follows it
+        guard !flushing else {
+            followUpQueued = true
+            return
+        }
+
+        flushing = true
+        followUpQueued = false
+        let completions = flushCompletions
+        flushCompletions.removeAll()
+        cancelTimer()
+        stats.attempts += 1
+
+        let started = DispatchTime.now()
+        let acknowledged = acknowledge?()
+
+        EchoFlushScheduler.flush(targets, on: queue) { bytes, failed in
+            let latency = TimeInterval(DispatchTime.now().uptimeNanoseconds - started.uptimeNanoseconds) / 1_000_000_000
+            self.stats.lastLatency = latency
+            self.stats.totalLatency += latency
+            self.stats.bytes += bytes
+            acknowledged?(!failed)
+
+            if failed {
+                self.stats.failures += 1
+                self.consecutiveFailures += 1
+            } else {
+                self.stats.successes += 1
+                self.consecutiveFailures = 0
+            }
+
+            self.flushing = false
+            completions.forEach { $0() }
+
+            if self.followUpQueued {
+                self.flush()
+            } else {
+                self.scheduleNextWindow()
+            }
+        }
+    }
+
+    /**
+     Flushes every target at once, calling `completion` on `queue` once all have reported back, with the
+     bytes sent and whether any failed.
+     */
+    static func flush(_ targets: [EchoFlushTarget], on queue: DispatchQueue,
+                      completion: @escaping (_ bytes: Int, _ failed: Bool) -> Void) {
+        let group = DispatchGroup()
+        var failed = false
+        var bytes = 0
+
+        for target in targets {
+            group.enter()
+            target.flush { outcome in
+                queue.async {
+                    switch outcome {
+                    case .sent(let sent):
+                        bytes += sent
+                    case .failed:
+                        failed = true
+                    case .handedOff:
+                        break
+                    }
+                    group.leave()
+                }
+            }
+        }
+
+        group.notify(queue: queue) {
+            completion(bytes, failed)
+        }
+    }
+
+}
@@ -0,0 +1,270 @@
+//
+//  EchoUserStateStore.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Everything Echo remembers about the user and device between launches, kept as one versioned record.
+ The `UserDefaults` keys the `UserPromiseHelper` reads and writes remain authoritative; this record
+ mirrors them so that Echo's own reads need not go through `UserDefaults`.
+ */
+internal struct EchoUserState: Codable, Equatable {
+
+    static let currentVersion = 1
+
+    var version = EchoUserState.currentVersion
+    var signedIn = false
+    var hashedID: String?
+    var tokenRefreshTimestamp: Date?
+    var deviceID: String?
+    var deviceIDCreationDate: Date?
+    var hardwareID: String?
+    /// Raw value of a `UserStateTransition` still to be reported
+    var postponedUserStateTransition: String?
+
+}
+
+/**
+ Where `EchoUserStateStore` keeps its record. `save` must replace the record atomically, so a crash
+ leaves either the previous record or the new one.
+ */
+internal protocol EchoUserStateBackend: class {
+    func load() -> Data?
+    func save(_ data: Data) throws
+    func remove() throws
+}
+
+/**
+ Keeps the record in a single file, replaced atomically by writing a temporary file and renaming it
+ over the old one.
+ */
+internal final class EchoFileUserStateBackend: EchoUserStateBackend {
+
+    let url: URL
+
+    init(url: URL = EchoFileUserStateBackend.defaultURL()) {
+        self.url = url
+    }
+
+    static func defaultURL() -> URL {
+        let support = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask).first
+                ?? URL(fileURLWithPath: NSTemporaryDirectory())
+        return support.appendingPathComponent("echo_user_state.json")
+    }
+
+    func load() -> Data? {
+        return try? Data(contentsOf: url)
+    }
+
+    func save(_ data: Data) throws {
+        try FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true,
+                                                attributes: nil)
+        try data.write(to: url, options: .atomic)
+    }
+
+    func remove() throws {
+        if FileManager.default.fileExists(atPath: url.path) {
+            try FileManager.default.removeItem(at: url)
+        }
+    }
+
+}
+
+/**
+ Holds the user state in memory and persists it in the background. Reads never touch storage; updates
+ change the in-memory record and schedule a write `coalescingInterval` seconds later, so a burst of
+ updates, e.g. from one `setBBCUser`, costs one write. `flush()` writes anything outstanding straight
+ away, e.g. when the app is backgrounded.
+
+ When there is no record yet, the state is migrated from the `UserDefaults` keys used by earlier
+ versions of Echo, so upgrading keeps the existing device ID and sign in state. Those keys are never
+ changed here, as the `UserPromiseHelper` still owns them. A record which cannot be read is treated
+ as missing.
+ */
+internal final class EchoUserStateStore {
+
+    enum Source {
+        /// Read from the backend
+        case record
+        /// Migrated from the keys used by earlier versions
+        case legacyDefaults
+        /// Nothing stored yet
+        case empty
+    }
+
+    private let backend: EchoUserStateBackend
+    private let coalescingInterval: TimeInterval
+    private let queue = DispatchQueue(label: "uk.co.bbc.echo.userstate")
+    private let lock = NSLock()
+
+    private var current: EchoUserState
+    private var changeCount: UInt64 = 0
+    private var persistedChangeCount: UInt64 = 0
+    private var writeScheduled = false
+
+    let source: Source
+    /// Number of records written to the backend
+    private(set) var writeCount = 0
+
+    init(backend: EchoUserStateBackend = EchoFileUserStateBackend(), legacyDefaults: UserDefaults? = .standard,
+         coalescingInterval: TimeInterval = 0.5) {
+        self.backend = backend
+        self.coalescingInterval = coalescingInterval
+
+        if let data = backend.load(), let record = EchoUserStateStore.decode(data) {
+            current = record
+            source = .record
+        } else if let defaults = legacyDefaults, let migrated = EchoUserStateStore.migrate(from: defaults) {
+            current = migrated
+            source = .legacyDefaults
+            // Write the record now, so the migration only happens once
+            changeCount = 1
+            scheduleWrite(after: 0)
+        } else {
+            current = EchoUserState()
+            source = .empty
+        }
+    }
+
+    var state: EchoUserState {
+        lock.lock()
+        defer { lock.unlock() }
+        return current
+    }
+
+    /// True while there are updates not yet written to the backend
+    var hasUnsavedChanges: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return changeCount != persistedChangeCount
+    }
+
+    func update(_ change: (inout EchoUserState) -> Void) {
+        lock.lock()
+        var updated = current
+        change(&updated)
+        guard updated != current else {
+            lock.unlock()
+            return
+        }
+
+        current = updated
+        changeCount += 1
+        let schedule = !writeScheduled
+        writeScheduled = true
+        lock.unlock()
+
+        if schedule {
+            scheduleWrite(after: coalescingInterval)
+        }
+    }
+
+    /// Writes any outstanding updates before returning
+    func flush() {
+        queue.sync {
+            write()
+        }
+    }
+
+    /**
+     Forgets the user state, as when the user's data is reset. Only the record is removed, so the next
+     launch migrates again from whatever the `UserPromiseHelper` has stored by then. Updates made after
+     this start a new record.
+     */
+    func clear() {
+        queue.sync {
+            lock.lock()
+            current = EchoUserState()
+            // Nothing outstanding, so a write already scheduled does not bring the old record back
+            persistedChangeCount = changeCount
+            lock.unlock()
+
+            do {
+                try backend.remove()
+            } catch {
+                EchoDebug.log(level: .error, message: "Unable to remove user state: \(error)")
+            }
+        }
+    }
+
+    private func scheduleWrite(after interval: TimeInterval) {
+        queue.asyncAfter(deadline: .now() + interval) { [weak self] in
+            self?.write()
+        }
+    }
+
+    /// Called on `queue`
+    private func write() {
+        lock.lock()
+        writeScheduled = false
+        guard changeCount != persistedChangeCount else {
+            lock.unlock()
+            return
+        }
+        let record = current
+        let writing = changeCount
+        lock.unlock()
+
+        do {
+            try backend.save(try EchoUserStateStore.encoder.encode(record))
+        } catch {
+            // Left unsaved, so the next update or flush tries again
+            EchoDebug.log(level: .error, message: "Unable to save user state: \(error)")
+            return
+        }
+
+        lock.lock()
+        persistedChangeCount = writing
+        writeCount += 1
+        lock.unlock()
+    }
+
+    private static let encoder: JSONEncoder = {
+        let encoder = JSONEncoder()
+        encoder.dateEncodingStrategy = .secondsSince1970
+        return encoder
+    }()
+
+    private static let decoder: JSONDecoder = {
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .secondsSince1970
+        return decoder
+    }()
+
+    private static func decode(_ data: Data) -> EchoUserState? {
+        guard var record = try? decoder.decode(EchoUserState.self, from: data) else {
+            EchoDebug.log(level: .warn, message: "Stored user state could not be read, ignoring it")
+            return nil
+        }
+
+        // Fields from later versions are dropped; the ones this version knows about are kept
+        record.version = EchoUserState.currentVersion
+        return record
+    }
+
+    /// The state stored by earlier versions, or nil if they stored none
+    static func migrate(from defaults: UserDefaults) -> EchoUserState? {
+        let deviceID = defaults.string(forKey: UserDefaultsKeys.echoDeviceID.rawValue)
+        let hashedID = defaults.string(forKey: UserDefaultsKeys.echoHashedID.rawValue)
+        let signedIn = defaults.object(forKey: UserDefaultsKeys.echoSignedIn.rawValue) as? Bool
+
+        guard deviceID != nil || hashedID != nil || signedIn != nil else {
+            return nil
+        }
+
+        var state = EchoUserState()
+        state.deviceID = deviceID
+        state.hashedID = hashedID
+        state.signedIn = signedIn ?? false
+        state.hardwareID = defaults.string(forKey: UserDefaultsKeys.echoHardwareID.rawValue)
+        if let created = defaults.object(forKey: UserDefaultsKeys.echoDeviceIDCreationDate.rawValue) as? Double {
+            state.deviceIDCreationDate = Date(timeIntervalSince1970: created)
+        }
+        return state
+    }
+
+}
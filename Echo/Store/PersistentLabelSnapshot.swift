@@ -0,0 +1,102 @@
+//
+//  PersistentLabelSnapshot.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ The persistent labels currently set, with a version that changes whenever they do. Stored and batched
+ events refer to a version rather than repeating every persistent label, and the labels for each
+ version are written once alongside them.
+
+ Settings the delegates take through their own setters, such as the producer, are held among the labels
+ under `Setting` keys, so that a replay can put them back through those setters.
+ */
+internal final class PersistentLabelSnapshot {
+
+    enum Setting: String, CaseIterable {
+        case destination = "echo_setting_destination"
+        case producer = "echo_setting_producer"
+        case contentLanguage = "echo_setting_content_language"
+
+        func apply(_ value: String, to delegate: EchoDelegate) {
+            switch self {
+            case .destination:
+                if let site = Int(value).flatMap(Destination.init(rawValue:)) {
+                    delegate.setDestination(site)
+                }
+            case .producer:
+                if let site = Int(value).flatMap(Producer.init(rawValue:)) {
+                    delegate.setProducer(site)
+                }
+            case .contentLanguage:
+                delegate.setContentLanguage(value)
+            }
+        }
+    }
+
+    /// Zero until the first label is set, so that events can use it to mean "no snapshot"
+    private(set) var version: UInt32 = 0
+    private(set) var labels = [String: String]()
+
+    func add(_ labels: [String: String]) {
+        var changed = false
+
+        for (key, value) in labels where self.labels[key] != value {
+            self.labels[key] = value
+            changed = true
+        }
+
+        if changed {
+            version += 1
+        }
+    }
+
+    func remove(_ keys: [String]) {
+        var changed = false
+
+        for key in keys where labels.removeValue(forKey: key) != nil {
+            changed = true
+        }
+
+        if changed {
+            version += 1
+        }
+    }
+
+    func set(_ setting: Setting, _ value: String) {
+        add([setting.rawValue: value])
+    }
+
+    /**
+     Brings `delegates` from the labels in `previous` to those in `labels`, setting any `Setting` through
+     its setter and adding or removing the rest as labels. A setting which is no longer present is left
+     as it was, as the delegates have no way to unset it.
+     */
+    static func apply(_ labels: [String: String], replacing previous: [String: String], to delegates: [EchoDelegate]) {
+        var plain = labels
+        var settings = [(Setting, String)]()
+        for setting in Setting.allCases {
+            if let value = plain.removeValue(forKey: setting.rawValue) {
+                settings.append((setting, value))
+            }
+        }
+        let removed = previous.keys.filter { labels[$0] == nil && Setting(rawValue: $0) == nil }
+
+        for delegate in delegates {
+            if !removed.isEmpty {
+                delegate.removeLabels(removed)
+            }
+            if !plain.isEmpty {
+                delegate.addLabels(plain)
+            }
+            for (setting, value) in settings {
+                setting.apply(value, to: delegate)
+            }
+        }
+    }
+
+}
@@ -0,0 +1,104 @@
+//
+//  ByteCoding.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Little endian helpers for the binary formats Echo writes to disk: schedule snapshots, event log
+ records and collector batches.
+ */
+internal extension Data {
+
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        var littleEndian = value.littleEndian
+        Swift.withUnsafeBytes(of: &littleEndian) { append(contentsOf: $0) }
+    }
+
+    /// Overwrites a value appended earlier, e.g. a count only known once the rest has been written
+    mutating func replaceLittleEndian<T: FixedWidthInteger>(_ value: T, at offset: Int) {
+        var littleEndian = value.littleEndian
+        let start = startIndex + offset
+        Swift.withUnsafeBytes(of: &littleEndian) { replaceSubrange(start..<(start + $0.count), with: $0) }
+    }
+
+    mutating func appendLengthPrefixed(_ string: String) {
+        let bytes = Array(string.utf8)
+        appendLittleEndian(UInt32(bytes.count))
+        append(contentsOf: bytes)
+    }
+
+    // Reads go through a copy so that they are safe regardless of the alignment of mapped bytes
+    func readLittleEndian<T: FixedWidthInteger>(_ type: T.Type, at offset: Int) -> T? {
+        let size = MemoryLayout<T>.size
+        guard offset >= 0, offset + size <= count else {
+            return nil
+        }
+
+        var value = T.zero
+        Swift.withUnsafeMutableBytes(of: &value) { buffer in
+            _ = copyBytes(to: buffer, from: (startIndex + offset)..<(startIndex + offset + size))
+        }
+        return T(littleEndian: value)
+    }
+
+    // For formats which check their bounds up front, e.g. `ScheduleSnapshot`; reads out of range give zero
+    func readUInt16(at offset: Int) -> UInt16 {
+        return readLittleEndian(UInt16.self, at: offset) ?? 0
+    }
+
+    func readUInt32(at offset: Int) -> UInt32 {
+        return readLittleEndian(UInt32.self, at: offset) ?? 0
+    }
+
+    func readUInt64(at offset: Int) -> UInt64 {
+        return readLittleEndian(UInt64.self, at: offset) ?? 0
+    }
+
+}
+
+/**
+ Sequential reader over `Data` written with the helpers above. Every read returns nil once the data runs out.
+ */
+internal struct ByteReader {
+
+    private let data: Data
+    private(set) var offset: Int
+
+    init(_ data: Data, offset: Int = 0) {
+        self.data = data
+        self.offset = offset
+    }
+
+    var remaining: Int {
+        return data.count - offset
+    }
+
+    mutating func read<T: FixedWidthInteger>(_ type: T.Type) -> T? {
+        guard let value = data.readLittleEndian(type, at: offset) else {
+            return nil
+        }
+        offset += MemoryLayout<T>.size
+        return value
+    }
+
+    mutating func readBytes(_ length: Int) -> Data? {
+        guard length >= 0, length <= remaining else {
+            return nil
+        }
+        let start = data.startIndex + offset
+        offset += length
+        return data.subdata(in: start..<(start + length))
+    }
+
+    mutating func readLengthPrefixedString() -> String? {
+        guard let length = read(UInt32.self), let bytes = readBytes(Int(length)) else {
+            return nil
+        }
+        return String(data: bytes, encoding: .utf8)
+    }
+
+}
@@ -0,0 +1,37 @@
+//
+//  CRC32.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ CRC-32 (IEEE 802.3, as used by zlib and gzip) for checking records Echo writes to disk.
+ */
+internal enum CRC32 {
+
+    private static let table: [UInt32] = (0..<256).map { index -> UInt32 in
+        var value = UInt32(index)
+        for _ in 0..<8 {
+            value = (value & 1) != 0 ? (0xEDB88320 ^ (value >> 1)) : (value >> 1)
+        }
+        return value
+    }
+
+    static func checksum(_ data: Data, seed: UInt32 = 0) -> UInt32 {
+        return data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> UInt32 in
+            return checksum(buffer, seed: seed)
+        }
+    }
+
+    static func checksum(_ buffer: UnsafeRawBufferPointer, seed: UInt32 = 0) -> UInt32 {
+        var crc = ~seed
+        for byte in buffer {
+            crc = table[Int((crc ^ UInt32(byte)) & 0xFF)] ^ (crc >> 8)
+        }
+        return ~crc
+    }
+
+}
@@ -0,0 +1,63 @@
+//
+//  EchoCompressionDictionary.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Preset deflate dictionaries for Echo payloads. A payload can only be inflated with the exact bytes it was
+ deflated with, so each dictionary is a frozen literal tied to its version: any change to the bytes must
+ come with a new version, and `EchoCompressionTests` checks each version's length and CRC.
+
+ `collector` holds JSON fragments of the collector batch format. `eventLog` holds the label keys and
+ values as `EchoEventRecord` writes them, each prefixed with its UInt32 little-endian length. zlib favours
+ matches near the end of the dictionary, so the most frequent strings come last.
+ */
+internal struct EchoCompressionDictionary {
+
+    /// Sent with compressed collector batches so the collector can select the matching dictionary
+    static let headerField = "X-Echo-Dictionary"
+
+    let version: Int
+    let data: Data
+
+    static let collector = EchoCompressionDictionary(version: 1, data: Data("""
+        "media_length":""media_is_live":"0""media_is_live":"1""media_service_id":""media_version_id":"\
+        "player_subtitled":"0""player_volume":""player_window_state":""destination":""producer":""trace":"\
+        "content_language":""live_edge_latency":""live_edge_latency_p50":""live_edge_latency_p95":"\
+        "ess_status_code":""ess_error":""ess_enriched":""ess_success":""ess_enabled":""media_timestamp":"\
+        "is_background":""player_version":""player_name":""app_name":""bbc_site":""event":"error"\
+        "event":"av_seek""event":"av_buffer""event":"av_pause""event":"av_end""event":"av_play"\
+        "event":"user_action""action_type":"echo_hb""name":"echo_hb_"event":"av_user_action""event":"view"\
+        "app_type":"mobile-app"":"true"":"false""position":"device":""app":""counter":""labels":{""ts":1},{"
+        """.utf8))
+
+    static let eventLog = EchoCompressionDictionary(version: 1, data: Data("""
+        \u{0C}\0\0\0media_length\u{0D}\0\0\0media_is_live\u{01}\0\0\u{0}0\u{0D}\0\0\0media_is_live\u{01}\0\0\u{0}1\
+        \u{10}\0\0\0media_service_id\u{10}\0\0\0media_version_id\u{10}\0\0\0player_subtitled\u{01}\0\0\u{0}0\
+        \u{0D}\0\0\0player_volume\u{13}\0\0\0player_window_state\u{0B}\0\0\0destination\u{08}\0\0\0producer\
+        \u{05}\0\0\0trace\u{10}\0\0\0content_language\u{11}\0\0\0live_edge_latency\
+        \u{15}\0\0\0live_edge_latency_p50\u{15}\0\0\0live_edge_latency_p95\u{0F}\0\0\0ess_status_code\
+        \u{09}\0\0\0ess_error\u{0C}\0\0\0ess_enriched\u{0B}\0\0\0ess_success\u{0B}\0\0\0ess_enabled\
+        \u{0D}\0\0\0is_background\u{05}\0\0\0false\u{0E}\0\0\0player_version\u{0B}\0\0\0player_name\
+        \u{08}\0\0\0app_type\u{0A}\0\0\0mobile-app\u{08}\0\0\0app_name\u{08}\0\0\0bbc_site\
+        \u{0F}\0\0\0media_timestamp\u{07}\0\0\0echo_hb\u{08}\0\0\0echo_hb_
+        """.utf8))
+
+    /// The event log dictionary a segment was written with, nil if this version of Echo does not have it
+    static func eventLogDictionary(version: Int) -> EchoCompressionDictionary? {
+        return version == eventLog.version ? eventLog : nil
+    }
+
+    func compress(_ payload: Data) -> Data? {
+        return EchoDeflate.compress(payload, dictionary: data)
+    }
+
+    func decompress(_ payload: Data) -> Data? {
+        return EchoDeflate.decompress(payload, dictionary: data)
+    }
+
+}
@@ -0,0 +1,103 @@
+//
+//  EchoDeflate.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import zlib
+
+/**
+ zlib deflate with an optional preset dictionary. Echo events are short and repeat the same label keys
+ and values, so priming the compressor with those strings compresses even a single event well.
+ */
+internal enum EchoDeflate {
+
+    static func compress(_ data: Data, dictionary: Data? = nil, level: Int32 = Z_DEFAULT_COMPRESSION) -> Data? {
+        var stream = z_stream()
+        guard deflateInit_(&stream, level, ZLIB_VERSION, Int32(MemoryLayout<z_stream>.size)) == Z_OK else {
+            return nil
+        }
+        defer { deflateEnd(&stream) }
+
+        if let dictionary = dictionary {
+            let status = dictionary.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> Int32 in
+                return deflateSetDictionary(&stream, buffer.bindMemory(to: Bytef.self).baseAddress, uInt(buffer.count))
+            }
+            guard status == Z_OK else {
+                return nil
+            }
+        }
+
+        var output = Data(count: Int(deflateBound(&stream, uLong(data.count))))
+        let outputCapacity = output.count
+
+        let status = data.withUnsafeBytes { (input: UnsafeRawBufferPointer) -> Int32 in
+            return output.withUnsafeMutableBytes { (out: UnsafeMutableRawBufferPointer) -> Int32 in
+                stream.next_in = UnsafeMutablePointer(mutating: input.bindMemory(to: Bytef.self).baseAddress)
+                stream.avail_in = uInt(input.count)
+                stream.next_out = out.bindMemory(to: Bytef.self).baseAddress
+                stream.avail_out = uInt(outputCapacity)
+                return deflate(&stream, Z_FINISH)
+            }
+        }
+
+        guard status == Z_STREAM_END else {
+            return nil
+        }
+
+        output.count = Int(stream.total_out)
+        return output
+    }
+
+    static func decompress(_ data: Data, dictionary: Data? = nil) -> Data? {
+        var stream = z_stream()
+        guard inflateInit_(&stream, ZLIB_VERSION, Int32(MemoryLayout<z_stream>.size)) == Z_OK else {
+            return nil
+        }
+        defer { inflateEnd(&stream) }
+
+        var output = Data()
+        var chunk = [UInt8](repeating: 0, count: max(4096, data.count * 4))
+
+        let finished = data.withUnsafeBytes { (input: UnsafeRawBufferPointer) -> Bool in
+            stream.next_in = UnsafeMutablePointer(mutating: input.bindMemory(to: Bytef.self).baseAddress)
+            stream.avail_in = uInt(input.count)
+
+            while true {
+                let chunkCount = chunk.count
+                var status = chunk.withUnsafeMutableBufferPointer { (out: inout UnsafeMutableBufferPointer<UInt8>) -> Int32 in
+                    stream.next_out = out.baseAddress
+                    stream.avail_out = uInt(chunkCount)
+                    return inflate(&stream, Z_NO_FLUSH)
+                }
+
+                if status == Z_NEED_DICT {
+                    guard let dictionary = dictionary else {
+                        return false
+                    }
+                    status = dictionary.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> Int32 in
+                        return inflateSetDictionary(&stream, buffer.bindMemory(to: Bytef.self).baseAddress, uInt(buffer.count))
+                    }
+                    guard status == Z_OK else {
+                        return false
+                    }
+                    continue
+                }
+
+                output.append(chunk, count: chunkCount - Int(stream.avail_out))
+
+                if status == Z_STREAM_END {
+                    return true
+                }
+                guard status == Z_OK else {
+                    return false
+                }
+            }
+        }
+
+        return finished ? output : nil
+    }
+
+}
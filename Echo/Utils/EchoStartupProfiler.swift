@@ -0,0 +1,99 @@
+//
+//  EchoStartupProfiler.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ How long each phase of an `EchoClient`'s initialisation took, in the order the phases ran. Only produced
+ when `EchoClient.startupProfilingEnabled` is set before the client is created.
+
+ Phases are `config` (collating and validating the configuration), `userPromiseHelper`, `deviceID`,
+ `webviewStorage` (starting cookie clearing, when idv5 is disabled; the clearing itself is not waited for),
+ `delegates` (the delegate factory, when delegates are not deferred) and `start`, which is followed by one
+ `start.<Delegate>` phase per delegate. `total` is the whole initialiser, so it also covers the work
+ between phases.
+ */
+public final class EchoStartupReport: NSObject {
+
+    public struct Phase {
+        public let name: String
+        public let duration: TimeInterval
+    }
+
+    public let phases: [Phase]
+    public let total: TimeInterval
+
+    internal init(phases: [Phase], total: TimeInterval) {
+        self.phases = phases
+        self.total = total
+        super.init()
+    }
+
+    /// The duration of the first phase called `name`, or nil if it did not run
+    public func duration(of name: String) -> TimeInterval? {
+        return phases.first { $0.name == name }?.duration
+    }
+
+    /// Durations in milliseconds keyed by phase name, including `total`, e.g. for attaching to launch traces
+    @objc public func millisecondsByPhase() -> [String: Double] {
+        var result = [String: Double](minimumCapacity: phases.count + 1)
+        for phase in phases {
+            result[phase.name] = phase.duration * 1000
+        }
+        result["total"] = total * 1000
+        return result
+    }
+
+    public override var description: String {
+        let lines = phases.map { String(format: "%@: %.3fms", $0.name, $0.duration * 1000) }
+        return (lines + [String(format: "total: %.3fms", total * 1000)]).joined(separator: "\n")
+    }
+
+}
+
+/**
+ Records monotonic timings for named phases until `finish()` is called. When created disabled, `measure`
+ just runs the work, so the client's initialiser can be written the same way whether profiling or not.
+ */
+internal final class EchoStartupProfiler {
+
+    private let started: UInt64
+    private var phases = [EchoStartupReport.Phase]()
+    private(set) var isRecording: Bool
+
+    init(enabled: Bool) {
+        isRecording = enabled
+        started = enabled ? DispatchTime.now().uptimeNanoseconds : 0
+    }
+
+    func measure<T>(_ name: String, _ work: () throws -> T) rethrows -> T {
+        guard isRecording else {
+            return try work()
+        }
+
+        let start = DispatchTime.now().uptimeNanoseconds
+        defer {
+            phases.append(EchoStartupReport.Phase(name: name, duration: EchoStartupProfiler.seconds(since: start)))
+        }
+        return try work()
+    }
+
+    /// Stops recording and returns the report, or nil if not recording
+    func finish() -> EchoStartupReport? {
+        guard isRecording else {
+            return nil
+        }
+
+        isRecording = false
+        return EchoStartupReport(phases: phases, total: EchoStartupProfiler.seconds(since: started))
+    }
+
+    private static func seconds(since start: UInt64) -> TimeInterval {
+        return TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+    }
+
+}
@@ -0,0 +1,143 @@
+//
+//  EchoTokenExpiryScheduler.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Tells `EchoClient` when the signed in user's token expires, so the delegates' user labels can be
+ updated. Runs on its own queue, so scheduling works from any thread whether or not it has a run loop,
+ and reads the time from a `TimeProtocol` so that tests can drive it with `MockClock`.
+
+ Only the latest user is tracked. Scheduling the same expiry again, as happens when `setBBCUser` is
+ called repeatedly with the same token, just replaces the user without resetting the timer. When the
+ token expires `onExpiry` is called once on `callbackQueue`, and not at all if a new user was scheduled
+ or the schedule cancelled in the meantime. `callbackQueue` must not be the scheduler's own queue.
+ */
+internal final class EchoTokenExpiryScheduler {
+
+    private let clock: TimeProtocol
+    private let queue: DispatchQueue
+    private let callbackQueue: DispatchQueue
+    private let onExpiry: (BBCUser) -> Void
+
+    private var timer: DispatchSourceTimer?
+    private var pending: (user: BBCUser, deadline: TimeInterval)?
+    private var generation: UInt64 = 0
+    private var rescheduled = 0
+    private var coalesced = 0
+
+    init(clock: TimeProtocol = SystemClock(), queue: DispatchQueue = DispatchQueue(label: "uk.co.bbc.echo.tokenexpiry"),
+         callbackQueue: DispatchQueue = .main, onExpiry: @escaping (BBCUser) -> Void) {
+        self.clock = clock
+        self.queue = queue
+        self.callbackQueue = callbackQueue
+        self.onExpiry = onExpiry
+    }
+
+    deinit {
+        timer?.cancel()
+    }
+
+    /// When the scheduled token expires, as a `clock` time, or nil if nothing is scheduled
+    var deadline: TimeInterval? {
+        return queue.sync { pending?.deadline }
+    }
+
+    /// Number of times the timer was set, and number of schedules which only replaced the user
+    var counts: (rescheduled: Int, coalesced: Int) {
+        return queue.sync { (rescheduled, coalesced) }
+    }
+
+    /**
+     Calls `onExpiry` with `user` once `timeUntilExpiry` seconds have passed, replacing anything
+     scheduled before. Nothing is scheduled for a token which has already expired.
+     */
+    func schedule(_ user: BBCUser, timeUntilExpiry: TimeInterval) {
+        let deadline = clock.currentTime() + timeUntilExpiry
+
+        queue.async {
+            guard timeUntilExpiry > 0 else {
+                self.cancelPending()
+                return
+            }
+
+            // Within a second of the current deadline is the same token scheduled again
+            if let pending = self.pending, abs(pending.deadline - deadline) < 1 {
+                self.pending = (user, pending.deadline)
+                self.coalesced += 1
+                return
+            }
+
+            self.cancelPending()
+            self.pending = (user, deadline)
+            self.rescheduled += 1
+            self.armTimer(delay: timeUntilExpiry)
+            EchoDebug.log(level: .info, message: "Scheduler set to check token in \(timeUntilExpiry) seconds")
+        }
+    }
+
+    func cancel() {
+        queue.async {
+            self.cancelPending()
+        }
+    }
+
+    /**
+     Expires the scheduled token if its deadline has passed by `clock`. Called when the timer fires,
+     and by tests after moving a `MockClock` on.
+     */
+    func expireIfDue() {
+        queue.sync {
+            fireIfDue()
+        }
+    }
+
+    // MARK: - Queue confined
+
+    private func armTimer(delay: TimeInterval) {
+        let timer = DispatchSource.makeTimerSource(queue: queue)
+        timer.schedule(deadline: .now() + delay, leeway: .seconds(1))
+        timer.setEventHandler { [weak self] in
+            self?.fireIfDue()
+        }
+        timer.resume()
+        self.timer = timer
+    }
+
+    private func cancelPending() {
+        timer?.cancel()
+        timer = nil
+        pending = nil
+        generation += 1
+    }
+
+    private func fireIfDue() {
+        guard let pending = pending else {
+            return
+        }
+
+        let remaining = pending.deadline - clock.currentTime()
+        guard remaining <= 0 else {
+            // Woken early, e.g. the clock was changed, so wait for the rest
+            timer?.cancel()
+            armTimer(delay: remaining)
+            return
+        }
+
+        cancelPending()
+        let firing = generation
+
+        callbackQueue.async {
+            // Dropped if a new user was scheduled before this ran
+            guard self.queue.sync(execute: { self.generation == firing }) else {
+                return
+            }
+            self.onExpiry(pending.user)
+        }
+    }
+
+}
@@ -0,0 +1,77 @@
+//
+//  EchoUserLabels.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ The parts of a `BBCUser` which the delegates derive their user labels from, worked out once in
+ `EchoClient` so that `updateBBCUserLabels` only needs to go to the delegates when one has changed.
+ */
+internal struct EchoUserLabels: Equatable {
+
+    enum Field: CaseIterable {
+        case signedIn
+        case hashedID
+        case tokenState
+        case personalisation
+    }
+
+    let signedIn: Bool
+    let hashedID: String?
+    /// `tokenState()` reduced to the states the labels distinguish
+    let tokenValid: Bool
+    let tokenExpired: Bool
+    /// Personalisation is on when a signed in user has a hashed ID
+    let personalisation: Bool
+
+    init(_ user: BBCUser) {
+        signedIn = user.signedIn
+        hashedID = user.hashedID
+        let tokenState = user.tokenState()
+        tokenValid = tokenState == .valid
+        tokenExpired = tokenState == .expired
+        personalisation = user.signedIn && user.hashedID != nil
+    }
+
+    /// Keys of every label in `labels`, whether or not it is currently set
+    static let keys = [EchoLabelKeys.BBCIDLoggedIn.rawValue, EchoLabelKeys.BBCHashedID.rawValue]
+
+    /// The user labels as the delegates set them: logged in only while signed in, and the hashed ID only with personalisation
+    var labels: [String: String] {
+        var labels = [String: String]()
+        if signedIn {
+            labels[EchoLabelKeys.BBCIDLoggedIn.rawValue] = "1"
+        }
+        if personalisation, let hashedID = hashedID {
+            labels[EchoLabelKeys.BBCHashedID.rawValue] = hashedID
+        }
+        return labels
+    }
+
+    /// The fields which differ from `previous`; every field when there is no previous
+    func changes(from previous: EchoUserLabels?) -> Set<Field> {
+        guard let previous = previous else {
+            return Set(Field.allCases)
+        }
+
+        var changed = Set<Field>()
+        if signedIn != previous.signedIn {
+            changed.insert(.signedIn)
+        }
+        if hashedID != previous.hashedID {
+            changed.insert(.hashedID)
+        }
+        if tokenValid != previous.tokenValid || tokenExpired != previous.tokenExpired {
+            changed.insert(.tokenState)
+        }
+        if personalisation != previous.personalisation {
+            changed.insert(.personalisation)
+        }
+        return changed
+    }
+
+}
@@ -0,0 +1,167 @@
+//
+//  EchoWebviewStorage.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Cookie and webview storage work which Echo does not need to wait for. `EchoWebviewStorageTask` calls
+ implementations on the main queue, as `WKWebsiteDataStore` and its cookie store must be used from main,
+ but after `EchoClient.init` has returned.
+ */
+internal protocol EchoWebviewStorage: class {
+    func clearWebviewCookies()
+}
+
+/**
+ Clears cookies through `UserPromise`, as `EchoClient` did during initialisation.
+ */
+internal final class UserPromiseWebviewStorage: EchoWebviewStorage {
+
+    private let userPromise: UserPromise
+
+    init(_ userPromise: UserPromise) {
+        self.userPromise = userPromise
+    }
+
+    func clearWebviewCookies() {
+        userPromise.clearWebviewCookies()
+    }
+
+}
+
+/**
+ Runs webview storage work asynchronously on the main queue. The task can be cancelled until the work
+ starts; once started it runs to the end. Cookie writes which must land after the work, such as those
+ `setBBCUser` makes, call `runPendingWork` first. `whenFinished` callbacks are called once, on the main
+ queue, with whether the work ran.
+ */
+internal final class EchoWebviewStorageTask {
+
+    enum Outcome {
+        case finished(duration: TimeInterval)
+        case cancelled
+    }
+
+    private let lock = NSLock()
+    private let callbackQueue: DispatchQueue
+    private let work: () -> Void
+    /// Left when the task finishes, whether or not the work ran
+    private let done = DispatchGroup()
+    private var started = false
+    private var cancelled = false
+    private var outcome: Outcome?
+    private var callbacks = [(Outcome) -> Void]()
+
+    /**
+     Queues `work` on `queue` and returns straight away.
+     */
+    init(queue: DispatchQueue = .main, callbackQueue: DispatchQueue = .main, work: @escaping () -> Void) {
+        self.callbackQueue = callbackQueue
+        self.work = work
+        done.enter()
+
+        queue.async {
+            guard self.start() else {
+                return
+            }
+            self.run()
+        }
+    }
+
+    static func clearingCookies(in storage: EchoWebviewStorage) -> EchoWebviewStorageTask {
+        return EchoWebviewStorageTask {
+            storage.clearWebviewCookies()
+        }
+    }
+
+    var isFinished: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return outcome != nil
+    }
+
+    /**
+     Stops the work from starting if it has not already. Cancelling has no effect once the work has
+     started, as cookie store calls cannot be interrupted part way: the work runs to the end, the task
+     finishes as `.finished` and this returns false.
+     */
+    @discardableResult
+    func cancel() -> Bool {
+        lock.lock()
+        guard !started else {
+            lock.unlock()
+            return false
+        }
+        cancelled = true
+        lock.unlock()
+
+        finish(.cancelled)
+        return true
+    }
+
+    /**
+     Makes sure the work is over before returning: runs it on the calling thread if it has not started,
+     or waits for it if it is running elsewhere. Returns at once if the task was cancelled.
+     */
+    func runPendingWork() {
+        if start() {
+            run()
+        } else {
+            done.wait()
+        }
+    }
+
+    func whenFinished(_ callback: @escaping (Outcome) -> Void) {
+        lock.lock()
+        guard let outcome = outcome else {
+            callbacks.append(callback)
+            lock.unlock()
+            return
+        }
+        lock.unlock()
+
+        callbackQueue.async {
+            callback(outcome)
+        }
+    }
+
+    /// Claims the work for the caller; false if it was cancelled or another caller has already started it
+    private func start() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !cancelled && !started else {
+            return false
+        }
+        started = true
+        return true
+    }
+
+    private func run() {
+        let begun = DispatchTime.now().uptimeNanoseconds
+        work()
+        let duration = TimeInterval(DispatchTime.now().uptimeNanoseconds - begun) / 1_000_000_000
+        finish(.finished(duration: duration))
+    }
+
+    private func finish(_ outcome: Outcome) {
+        lock.lock()
+        guard self.outcome == nil else {
+            lock.unlock()
+            return
+        }
+        self.outcome = outcome
+        let callbacks = self.callbacks
+        self.callbacks.removeAll()
+        lock.unlock()
+        done.leave()
+
+        callbackQueue.async {
+            callbacks.forEach { $0(outcome) }
+        }
+    }
+
+}
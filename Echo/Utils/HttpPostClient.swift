@@ -0,0 +1,54 @@
+//
+//  HttpPostClient.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+internal enum HttpPostResult {
+    case success(statusCode: Int)
+    /// statusCode is nil when no response was received
+    case failure(statusCode: Int?)
+}
+
+/**
+ Counterpart to `HttpClientProtocol` for sending data, used by delegates which upload to an Echo collector.
+ */
+internal protocol HttpPostClientProtocol: class {
+
+    func post(_ body: Data, to url: URL, headers: [String: String], completion: @escaping (HttpPostResult) -> Void)
+
+}
+
+internal class HttpPostClient: HttpPostClientProtocol {
+
+    private let session: URLSession
+    private let timeout: TimeInterval
+
+    init(session: URLSession = URLSession.shared, timeout: TimeInterval = 30) {
+        self.session = session
+        self.timeout = timeout
+    }
+
+    func post(_ body: Data, to url: URL, headers: [String: String], completion: @escaping (HttpPostResult) -> Void) {
+        var request = URLRequest(url: url, cachePolicy: .reloadIgnoringLocalCacheData, timeoutInterval: timeout)
+        request.httpMethod = "POST"
+        request.httpBody = body
+        for (field, value) in headers {
+            request.setValue(value, forHTTPHeaderField: field)
+        }
+
+        session.dataTask(with: request) { _, response, error in
+            let statusCode = (response as? HTTPURLResponse)?.statusCode
+
+            if error == nil, let statusCode = statusCode, (200..<300).contains(statusCode) {
+                completion(.success(statusCode: statusCode))
+            } else {
+                completion(.failure(statusCode: statusCode))
+            }
+        }.resume()
+    }
+
+}
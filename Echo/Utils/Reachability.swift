@@ -0,0 +1,78 @@
+//
+//  Reachability.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import SystemConfiguration
+
+/**
+ Source of network reachability, so that components which only send when online can be driven by a
+ simulated source in tests.
+ */
+internal protocol ReachabilitySource: class {
+
+    var isReachable: Bool { get }
+
+    /// Called on an arbitrary queue whenever reachability changes
+    var reachabilityChanged: ((Bool) -> Void)? { get set }
+
+}
+
+/**
+ `SCNetworkReachability` backed source. Reachability is only a hint: a host reported reachable may still
+ fail, so callers must handle send failures regardless.
+ */
+internal final class SystemReachability: ReachabilitySource {
+
+    private let reachability: SCNetworkReachability?
+    private let queue = DispatchQueue(label: "uk.co.bbc.echo.reachability")
+
+    var reachabilityChanged: ((Bool) -> Void)?
+
+    init(host: String = "www.bbc.co.uk") {
+        reachability = SCNetworkReachabilityCreateWithName(nil, host)
+
+        guard let reachability = reachability else {
+            EchoDebug.log(level: .warn, message: "Unable to monitor reachability of \(host)")
+            return
+        }
+
+        var context = SCNetworkReachabilityContext(version: 0, info: Unmanaged.passUnretained(self).toOpaque(),
+                                                   retain: nil, release: nil, copyDescription: nil)
+        let callback: SCNetworkReachabilityCallBack = { _, flags, info in
+            guard let info = info else {
+                return
+            }
+            let source = Unmanaged<SystemReachability>.fromOpaque(info).takeUnretainedValue()
+            source.reachabilityChanged?(SystemReachability.isReachable(flags))
+        }
+
+        if SCNetworkReachabilitySetCallback(reachability, callback, &context) {
+            SCNetworkReachabilitySetDispatchQueue(reachability, queue)
+        }
+    }
+
+    deinit {
+        if let reachability = reachability {
+            SCNetworkReachabilitySetCallback(reachability, nil, nil)
+            SCNetworkReachabilitySetDispatchQueue(reachability, nil)
+        }
+    }
+
+    var isReachable: Bool {
+        var flags = SCNetworkReachabilityFlags()
+        guard let reachability = reachability, SCNetworkReachabilityGetFlags(reachability, &flags) else {
+            // Unknown, so assume online and let sends fail if not
+            return true
+        }
+        return SystemReachability.isReachable(flags)
+    }
+
+    private static func isReachable(_ flags: SCNetworkReachabilityFlags) -> Bool {
+        return flags.contains(.reachable) && !flags.contains(.connectionRequired)
+    }
+
+}
@@ -0,0 +1,19 @@
+//
+//  SystemClock.swift
+//  Echo
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Wall clock time source for components which take a `TimeProtocol` so that they can be driven by `MockClock` in tests.
+ */
+internal class SystemClock: TimeProtocol {
+
+    func currentTime() -> TimeInterval {
+        return Date().timeIntervalSince1970
+    }
+
+}
@@ -0,0 +1,140 @@
+//
+//  CollectorStandInServer.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+@testable import Echo
+
+/**
+ In-process stand-in for an Echo collector. POSTs to `CollectorStandInServer.host` made through the
+ URL loading system are recorded and answered locally, optionally failing the first few requests.
+
+ Register with `CollectorStandInServer.start(_:)` and point a collector delegate at `CollectorStandInServer.url`.
+ */
+class CollectorStandInServer: URLProtocol {
+
+    static let host = "collector.standin.local"
+    static let url = URL(string: "https://\(host)/events")!
+
+    struct Configuration {
+        var latency: TimeInterval = 0
+        /// Respond to this many requests with `failureStatusCode` before accepting any
+        var failFirstRequests = 0
+        var failureStatusCode = 503
+
+        init() {
+        }
+    }
+
+    struct Received {
+        let session: String?
+        let batch: Int
+        /// Events with their persistent label snapshots expanded
+        let events: [[String: Any]]
+        let bytes: Int
+    }
+
+    private static let lock = NSLock()
+    private static var configuration = Configuration()
+    private static var requests = 0
+    private static var accepted = [Received]()
+
+    static func start(_ configuration: Configuration = Configuration()) {
+        lock.lock()
+        self.configuration = configuration
+        requests = 0
+        accepted = []
+        lock.unlock()
+
+        URLProtocol.registerClass(CollectorStandInServer.self)
+    }
+
+    static func stop() {
+        URLProtocol.unregisterClass(CollectorStandInServer.self)
+    }
+
+    static var requestCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return requests
+    }
+
+    /// Batches which were accepted, in the order they arrived
+    static var received: [Received] {
+        lock.lock()
+        defer { lock.unlock() }
+        return accepted
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool {
+        return request.url?.host == host
+    }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        return request
+    }
+
+    override func startLoading() {
+        var body = CollectorStandInServer.body(of: request)
+        let bytes = body.count
+
+        if request.value(forHTTPHeaderField: "Content-Encoding") == "deflate" {
+            body = EchoCompressionDictionary.collector.decompress(body) ?? Data()
+        }
+
+        CollectorStandInServer.lock.lock()
+        let configuration = CollectorStandInServer.configuration
+        CollectorStandInServer.requests += 1
+        let fail = CollectorStandInServer.requests <= configuration.failFirstRequests
+        if !fail, let json = (try? JSONSerialization.jsonObject(with: body, options: [])) as? [String: Any] {
+            CollectorStandInServer.accepted.append(Received(session: json["session"] as? String,
+                                                            batch: json["batch"] as? Int ?? 0,
+                                                            events: EchoCollectorBatchDecoder.events(in: json),
+                                                            bytes: bytes))
+        }
+        CollectorStandInServer.lock.unlock()
+
+        DispatchQueue.global().asyncAfter(deadline: .now() + configuration.latency) { [weak self] in
+            guard let self = self, let url = self.request.url else {
+                return
+            }
+
+            let statusCode = fail ? configuration.failureStatusCode : 204
+            let response = HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: nil)!
+
+            self.client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+            self.client?.urlProtocolDidFinishLoading(self)
+        }
+    }
+
+    override func stopLoading() {
+    }
+
+    // URLSession hands the body to protocols as a stream rather than httpBody
+    private static func body(of request: URLRequest) -> Data {
+        if let body = request.httpBody {
+            return body
+        }
+
+        guard let stream = request.httpBodyStream else {
+            return Data()
+        }
+
+        var data = Data()
+        var buffer = [UInt8](repeating: 0, count: 4096)
+        stream.open()
+        while stream.hasBytesAvailable {
+            let read = stream.read(&buffer, maxLength: buffer.count)
+            if read <= 0 {
+                break
+            }
+            data.append(buffer, count: read)
+        }
+        stream.close()
+        return data
+    }
+
+}
@@ -0,0 +1,182 @@
+//
+//  EssStandInServer.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+
+/**
+ In-process stand-in for ESS. Between `start(_:)` and `stop()` it is registered with the URL loading
+ system, so requests for `EssStandInServer.host` made through the shared session, as Echo's own ESS
+ client makes them, are answered locally with a schedule, after a configurable latency, and can be made
+ to fail. Requests for any other host are left alone.
+
+ Point Echo at it with `config[.essURL] = EssStandInServer.host`.
+ */
+class EssStandInServer: URLProtocol {
+
+    static let host = "ess.standin.local"
+
+    enum ScheduleSource {
+        /// Serve a recorded response, such as ess_sample.json
+        case recorded(Data)
+        /// Serve back to back broadcasts of `slotLength` seconds covering `start` to `end`
+        case generated(serviceId: String, start: TimeInterval, end: TimeInterval, slotLength: TimeInterval)
+    }
+
+    struct Configuration {
+        var schedule: ScheduleSource
+        var latency: TimeInterval = 0
+        var statusCode: Int = 200
+        /// Fraction of requests, between 0 and 1, that fail with `failureStatusCode`
+        var failureRate: Double = 0
+        /// Seeds the choice of which requests fail, so that a run can be repeated
+        var seed: UInt64 = 1
+        var failureStatusCode: Int = 503
+        /// Never respond, so that clients hit their own timeout
+        var dropRequests: Bool = false
+
+        init(schedule: ScheduleSource) {
+            self.schedule = schedule
+        }
+    }
+
+    private static let lock = NSLock()
+    private static var configuration = Configuration(schedule: .recorded(Data()))
+    private static var requests = 0
+    private static var failures = 0
+    private static var responseBody: Data?
+    private static var random = SeededGenerator(seed: 1)
+
+    /// SplitMix64, which is plenty for picking failures reproducibly
+    struct SeededGenerator: RandomNumberGenerator {
+        private var state: UInt64
+
+        init(seed: UInt64) {
+            state = seed
+        }
+
+        mutating func next() -> UInt64 {
+            state &+= 0x9E3779B97F4A7C15
+            var z = state
+            z = (z ^ (z >> 30)) &* 0xBF58476D1CE4E5B9
+            z = (z ^ (z >> 27)) &* 0x94D049BB133111EB
+            return z ^ (z >> 31)
+        }
+    }
+
+    static func start(_ configuration: Configuration) {
+        lock.lock()
+        self.configuration = configuration
+        requests = 0
+        failures = 0
+        responseBody = nil
+        random = SeededGenerator(seed: configuration.seed)
+        lock.unlock()
+        URLProtocol.registerClass(EssStandInServer.self)
+    }
+
+    static func stop() {
+        URLProtocol.unregisterClass(EssStandInServer.self)
+    }
+
+    static var requestCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return requests
+    }
+
+    static var failureCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return failures
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool {
+        return request.url?.host == host
+    }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        return request
+    }
+
+    override func startLoading() {
+        EssStandInServer.lock.lock()
+        let configuration = EssStandInServer.configuration
+        EssStandInServer.requests += 1
+        let fail = configuration.failureRate > 0 && Double.random(in: 0..<1, using: &EssStandInServer.random) < configuration.failureRate
+        if fail {
+            EssStandInServer.failures += 1
+        }
+        if EssStandInServer.responseBody == nil {
+            EssStandInServer.responseBody = EssStandInServer.body(for: configuration.schedule)
+        }
+        let body = EssStandInServer.responseBody ?? Data()
+        EssStandInServer.lock.unlock()
+
+        if configuration.dropRequests {
+            return
+        }
+
+        DispatchQueue.global().asyncAfter(deadline: .now() + configuration.latency) { [weak self] in
+            guard let self = self, let url = self.request.url else {
+                return
+            }
+
+            let statusCode = fail ? configuration.failureStatusCode : configuration.statusCode
+            let response = HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: "HTTP/1.1",
+                                           headerFields: ["Content-Type": "application/json"])!
+
+            self.client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+            if statusCode == 200 {
+                self.client?.urlProtocol(self, didLoad: body)
+            }
+            self.client?.urlProtocolDidFinishLoading(self)
+        }
+    }
+
+    override func stopLoading() {
+    }
+
+    private static func body(for source: ScheduleSource) -> Data {
+        switch source {
+        case .recorded(let data):
+            return data
+        case let .generated(serviceId, start, end, slotLength):
+            return generateSchedule(serviceId: serviceId, start: start, end: end, slotLength: slotLength)
+        }
+    }
+
+    static func generateSchedule(serviceId: String, start: TimeInterval, end: TimeInterval, slotLength: TimeInterval) -> Data {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.timeZone = TimeZone(secondsFromGMT: 0)
+        formatter.dateFormat = "yyyy-MM-dd'T'HH:mm:ss.SSS'Z'"
+
+        var items = [[String: Any]]()
+        var slotStart = start
+        var index = 0
+
+        while slotStart < end {
+            let slotEnd = min(slotStart + slotLength, end)
+            items.append([
+                "id": "p\(index)",
+                "version": ["id": "v\(index)"],
+                "episode": ["id": "e\(index)", "title": "Generated Episode \(index)"],
+                "brand": ["title": "Generated Brand \(index % 10)"],
+                "published_time": [
+                    "start": formatter.string(from: Date(timeIntervalSince1970: slotStart)),
+                    "end": formatter.string(from: Date(timeIntervalSince1970: slotEnd))
+                ]
+            ])
+            slotStart = slotEnd
+            index += 1
+        }
+
+        let json: [String: Any] = ["service": ["id": serviceId, "name": serviceId], "items": items]
+        return (try? JSONSerialization.data(withJSONObject: json, options: [])) ?? Data()
+    }
+
+}
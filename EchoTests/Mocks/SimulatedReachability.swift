@@ -0,0 +1,32 @@
+//
+//  SimulatedReachability.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+@testable import Echo
+
+/**
+ Reachability which changes only when a test says so.
+ */
+class SimulatedReachability: ReachabilitySource {
+
+    var reachabilityChanged: ((Bool) -> Void)?
+
+    private(set) var isReachable: Bool
+
+    init(reachable: Bool = true) {
+        isReachable = reachable
+    }
+
+    func set(reachable: Bool) {
+        guard reachable != isReachable else {
+            return
+        }
+        isReachable = reachable
+        reachabilityChanged?(reachable)
+    }
+
+}
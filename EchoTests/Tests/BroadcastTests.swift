@@ -0,0 +1,118 @@
+//
+//  BroadcastTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class BroadcastTests: XCTestCase {
+
+    var pool: BroadcastStringPool!
+
+    override func setUp() {
+        super.setUp()
+        pool = BroadcastStringPool()
+    }
+
+    func testBroadcastReturnsTheValuesItWasCreatedWith() {
+        let broadcast = Broadcast(startTime: 12345, endTime: 1122345, episodeId: "epId",
+                                  episodeTitle: "Sherlock", id: "1", versionId: "b038nzy4", brandTitle: "title", pool: pool)
+
+        XCTAssertEqual(12345, broadcast.startTime)
+        XCTAssertEqual(1122345, broadcast.endTime)
+        XCTAssertEqual("epId", broadcast.episodeId)
+        XCTAssertEqual("Sherlock", broadcast.episodeTitle)
+        XCTAssertEqual("1", broadcast.id)
+        XCTAssertEqual("b038nzy4", broadcast.versionId)
+        XCTAssertEqual("title", broadcast.brandTitle)
+    }
+
+    func testEmptyStringsAreNotPooled() {
+        let broadcast = Broadcast(startTime: 0, endTime: 1, episodeId: "", episodeTitle: "",
+                                  id: "", versionId: "", brandTitle: "", pool: pool)
+
+        XCTAssertEqual("", broadcast.brandTitle)
+        XCTAssertEqual("", broadcast.versionId)
+        XCTAssertEqual(0, pool.byteCount)
+    }
+
+    func testLookupDictionariesAreCounted() {
+        _ = Broadcast(startTime: 0, endTime: 1, episodeId: "", episodeTitle: "A Long Enough Episode Title",
+                      id: "", versionId: "", brandTitle: "", pool: pool)
+        let title = "A Long Enough Episode Title".utf8.count
+
+        // The UTF-8 copy and its range, plus the dictionary key and bucket
+        XCTAssertGreaterThanOrEqual(pool.byteCount, 2 * title + MemoryLayout<Range<Int>>.stride
+                                    + MemoryLayout<String>.stride + MemoryLayout<BroadcastStringPool.Ref>.stride)
+    }
+
+    func testRepeatedStringsShareOneEntry() {
+        _ = Broadcast(startTime: 0, endTime: 1, episodeId: "ep1", episodeTitle: "Episode",
+                      id: "1", versionId: "v1", brandTitle: "Brand Title", pool: pool)
+        let sizeAfterOne = pool.byteCount
+
+        _ = Broadcast(startTime: 1, endTime: 2, episodeId: "ep1", episodeTitle: "Episode",
+                      id: "1", versionId: "v1", brandTitle: "Brand Title", pool: pool)
+
+        XCTAssertEqual(sizeAfterOne, pool.byteCount)
+    }
+
+    func testBroadcastsAreEqualAcrossPools() {
+        let first = Broadcast(startTime: 0, endTime: 1, episodeId: "ep1", episodeTitle: "Episode",
+                              id: "1", versionId: "v1", brandTitle: "Brand", pool: pool)
+        let second = Broadcast(startTime: 0, endTime: 1, episodeId: "ep1", episodeTitle: "Episode",
+                               id: "1", versionId: "v1", brandTitle: "Brand", pool: BroadcastStringPool())
+        let different = Broadcast(startTime: 0, endTime: 1, episodeId: "ep1", episodeTitle: "Episode",
+                                  id: "1", versionId: "v2", brandTitle: "Brand", pool: pool)
+
+        XCTAssertEqual(first, second)
+        XCTAssertNotEqual(first, different)
+    }
+
+    // A week of 15 minute slots across 20 services, with a small set of recurring brands
+    func testMemoryOfLargeSyntheticSchedule() {
+        let brands = (0..<40).map { "Brand Title Number \($0) With A Realistic Length" }
+        var broadcasts = [Broadcast]()
+        var inlineStringBytes = 0
+
+        for service in 0..<20 {
+            for slot in 0..<(7 * 24 * 4) {
+                let brand = brands[(service + slot) % brands.count]
+                let episodeTitle = "\(brand): Series \(slot % 5) - Episode \(slot % 12)"
+                let strings = ["p\(service)_\(slot)", "v\(service)_\(slot)", "e\(slot % 300)", episodeTitle, brand]
+
+                // Strings over 15 UTF-8 bytes are heap allocated when stored inline
+                inlineStringBytes += strings.reduce(0) { $0 + ($1.utf8.count > 15 ? $1.utf8.count + 32 : 0) }
+
+                let start = TimeInterval(slot * 900)
+                broadcasts.append(Broadcast(startTime: start, endTime: start + 900, episodeId: strings[2],
+                                            episodeTitle: episodeTitle, id: strings[0], versionId: strings[1],
+                                            brandTitle: brand, pool: pool))
+            }
+        }
+
+        let inlineBytes = broadcasts.count * (2 * MemoryLayout<TimeInterval>.stride + 5 * MemoryLayout<String>.stride)
+                + inlineStringBytes
+        // Includes the pool's lookup dictionaries. The saving is in the repeated titles: IDs are unique to
+        // each broadcast, so pooling them costs about as much as holding them inline.
+        let pooledBytes = broadcasts.count * MemoryLayout<Broadcast>.stride + pool.byteCount
+
+        XCTAssertLessThan(pooledBytes, inlineBytes)
+    }
+
+    func testPerformanceOfBuildingLargeSyntheticSchedule() {
+        measure {
+            let pool = BroadcastStringPool()
+            for slot in 0..<(7 * 24 * 4 * 20) {
+                _ = Broadcast(startTime: TimeInterval(slot), endTime: TimeInterval(slot + 1), episodeId: "e\(slot % 300)",
+                              episodeTitle: "Episode \(slot % 300)", id: "p\(slot)", versionId: "v\(slot)",
+                              brandTitle: "Brand \(slot % 40)", pool: pool)
+            }
+        }
+    }
+
+}
@@ -0,0 +1,199 @@
+//
+//  EchoCachePolicyTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoCachePolicyTests: XCTestCase {
+
+    var directory: URL!
+
+    let padding = String(repeating: "x", count: 200)
+
+    override func setUp() {
+        super.setUp()
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent("EchoCachePolicyTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() {
+        CollectorStandInServer.stop()
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func makeLog(_ policy: EchoCachePolicy) throws -> EchoEventLog {
+        return try EchoEventLog(directory: directory, cachePolicy: policy)
+    }
+
+    func record(_ kind: EchoEventRecord.Kind, _ index: Int) -> EchoEventRecord {
+        return EchoEventRecord(kind: kind, timestamp: 1455290000 + TimeInterval(index), name: "event.\(index)",
+                               type: kind == .avUserAction ? "echo_hb" : "", position: UInt64(index) * 1000,
+                               labels: ["padding": padding])
+    }
+
+    /// Appends play, heartbeats and end for each session, as a download played offline would
+    func appendSessions(_ count: Int, heartbeatsPerSession: Int = 20, to log: EchoEventLog) {
+        var index = 0
+        for _ in 0..<count {
+            log.append(record(.avPlay, index))
+            index += 1
+            for _ in 0..<heartbeatsPerSession {
+                log.append(record(.avUserAction, index))
+                index += 1
+            }
+            log.append(record(.avEnd, index))
+            index += 1
+        }
+    }
+
+    func records(in log: EchoEventLog) -> [EchoEventRecord] {
+        log.drain()
+        var records = [EchoEventRecord]()
+        log.forEachRecord(after: log.deliveredThrough) { _, record in records.append(record) }
+        return records
+    }
+
+    func directorySize() -> Int {
+        let files = (try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: [.fileSizeKey], options: [])) ?? []
+        return files.filter { $0.pathExtension == EchoEventLog.segmentExtension }
+                .reduce(0) { $0 + ((try? $1.resourceValues(forKeys: [.fileSizeKey]).fileSize ?? 0) ?? 0) }
+    }
+
+    func testPolicyIsReadFromConfig() {
+        let policy = EchoCachePolicy(config: [.echoCacheMaxBytes: "1048576",
+                                              .echoCacheEviction: "oldest_first",
+                                              .echoCacheKeepStartAndEnd: "false",
+                                              .echoCacheQuota("collector"): "65536"])
+
+        XCTAssertEqual(EchoCachePolicy(maxBytes: 1048576, eviction: .oldestFirst, keepStartAndEnd: false,
+                                       delegateQuotas: ["collector": 65536]), policy)
+        XCTAssertNil(EchoCachePolicy(config: [:]))
+    }
+
+    func testInvalidConfigFallsBackToDefaults() {
+        let policy = EchoCachePolicy(config: [.echoCacheMaxBytes: "lots",
+                                              .echoCacheEviction: "newest_first",
+                                              .echoCacheQuota("collector"): "-1"])
+
+        XCTAssertEqual(EchoCachePolicy(), policy)
+    }
+
+    func testOldestFirstKeepsTheStoreWithinBudget() throws {
+        let policy = EchoCachePolicy(maxBytes: 64 * 1024, eviction: .oldestFirst, keepStartAndEnd: false)
+        let log = try makeLog(policy)
+
+        for index in 0..<2000 {
+            log.append(record(.view, index))
+        }
+
+        let remaining = records(in: log)
+        XCTAssertLessThanOrEqual(log.storedBytes, policy.maxBytes)
+        XCTAssertLessThanOrEqual(directorySize(), policy.maxBytes)
+        XCTAssertGreaterThan(log.evictedRecords, 0)
+        XCTAssertEqual(2000, log.evictedRecords + remaining.count)
+        XCTAssertEqual("event.1999", remaining.last?.name)
+        XCTAssertEqual((2000 - remaining.count..<2000).map { "event.\($0)" }, remaining.map { $0.name })
+    }
+
+    func testHeartbeatsAreEvictedBeforeStartAndEndEvents() throws {
+        let policy = EchoCachePolicy(maxBytes: 64 * 1024, eviction: .heartbeatsFirst, keepStartAndEnd: true)
+        let log = try makeLog(policy)
+
+        appendSessions(40, to: log)
+
+        let remaining = records(in: log)
+        XCTAssertLessThanOrEqual(log.storedBytes, policy.maxBytes)
+        XCTAssertEqual(40, remaining.filter { $0.kind == .avPlay }.count)
+        XCTAssertEqual(40, remaining.filter { $0.kind == .avEnd }.count)
+        XCTAssertLessThan(remaining.filter { $0.kind == .avUserAction }.count, 40 * 20)
+        XCTAssertEqual(remaining.map { $0.timestamp }.sorted(), remaining.map { $0.timestamp })
+    }
+
+    func testStartAndEndEventsAreEvictedOnceNothingElseIsLeft() throws {
+        let policy = EchoCachePolicy(maxBytes: 32 * 1024, eviction: .heartbeatsFirst, keepStartAndEnd: true)
+        let log = try makeLog(policy)
+
+        appendSessions(200, heartbeatsPerSession: 0, to: log)
+
+        let remaining = records(in: log)
+        XCTAssertLessThanOrEqual(log.storedBytes, policy.maxBytes)
+        XCTAssertEqual("event.399", remaining.last?.name)
+        XCTAssertEqual(400, log.evictedRecords + remaining.count)
+    }
+
+    func testOldestFirstCanStillKeepStartAndEndEvents() throws {
+        let policy = EchoCachePolicy(maxBytes: 64 * 1024, eviction: .oldestFirst, keepStartAndEnd: true)
+        let log = try makeLog(policy)
+
+        appendSessions(40, to: log)
+
+        let remaining = records(in: log)
+        XCTAssertLessThanOrEqual(log.storedBytes, policy.maxBytes)
+        XCTAssertEqual(40, remaining.filter { $0.kind == .avPlay }.count)
+        XCTAssertEqual(40, remaining.filter { $0.kind == .avEnd }.count)
+    }
+
+    func testDeliveredRecordsAreEvictedFirst() throws {
+        let policy = EchoCachePolicy(maxBytes: 64 * 1024, eviction: .oldestFirst, keepStartAndEnd: false)
+        let log = try makeLog(policy)
+
+        for index in 0..<120 {
+            log.append(record(.view, index))
+        }
+        log.markDelivered(through: 100)
+
+        for index in 120..<250 {
+            log.append(record(.view, index))
+        }
+        log.drain()
+
+        XCTAssertLessThanOrEqual(log.storedBytes, policy.maxBytes)
+        XCTAssertEqual(0, log.evictedRecords)
+        XCTAssertEqual((100..<250).map { "event.\($0)" }, records(in: log).map { $0.name })
+    }
+
+    func testEvictedLogIsRecoveredWhenReopened() throws {
+        let policy = EchoCachePolicy(maxBytes: 64 * 1024, eviction: .heartbeatsFirst, keepStartAndEnd: true)
+        var log: EchoEventLog? = try makeLog(policy)
+        appendSessions(40, to: log!)
+        let lastSequence = log!.lastSequence
+        let expected = records(in: log!)
+        log = nil
+
+        let reopened = try makeLog(policy)
+
+        XCTAssertEqual(lastSequence, reopened.lastSequence)
+        XCTAssertEqual(0, reopened.truncatedSegments)
+        XCTAssertEqual(expected, records(in: reopened))
+        XCTAssertEqual(lastSequence + 1, reopened.append(record(.view, 0)))
+    }
+
+    func testCollectorQueueIsHeldToItsQuota() {
+        var server = CollectorStandInServer.Configuration()
+        server.failFirstRequests = Int.max
+        CollectorStandInServer.start(server)
+
+        var configuration = EchoCollectorBatcher.Configuration()
+        configuration.maxEvents = 1
+        configuration.retryBaseDelay = 60
+        let policy = EchoCachePolicy(delegateQuotas: [EchoCollectorDelegate.cacheQuotaName: 2048])
+        let delegate = EchoCollectorDelegate(appName: "collector_test", collectorURL: CollectorStandInServer.url,
+                                             configuration: configuration, cachePolicy: policy)
+        delegate.start()
+
+        for index in 0..<100 {
+            delegate.viewEvent(counterName: "page.\(index)", eventLabels: ["padding": padding])
+        }
+        delegate.waitUntilIdle()
+
+        XCTAssertEqual(100, delegate.statistics.events)
+        XCTAssertGreaterThan(delegate.statistics.droppedBatches, 80)
+    }
+
+}
@@ -0,0 +1,154 @@
+//
+//  EchoClientDeferredDelegatesTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import Cuckoo
+import XCTest
+@testable import Echo
+
+class EchoClientDeferredDelegatesTests: EchoClientTests {
+
+    class RecordingDelegate: EchoDelegateMock {
+        var calls = [String]()
+
+        override func start() {
+            calls.append("start")
+        }
+
+        override func addLabels(_ labels: [String: String]) {
+            calls.append("addLabels:\(labels.keys.sorted().joined(separator: ","))")
+        }
+
+        override func removeLabels(_ labels: [String]) {
+            calls.append("removeLabels:\(labels.sorted().joined(separator: ","))")
+        }
+
+        override func setCounterName(_ counterName: String) {
+            calls.append("setCounterName:\(counterName)")
+        }
+
+        override func viewEvent(counterName: String, eventLabels: [String: String]?) {
+            calls.append("view:\(counterName)")
+        }
+    }
+
+    var recording: RecordingDelegate!
+
+    override func setUp() {
+        super.setUp()
+
+        recording = RecordingDelegate()
+        reset(factoryMock)
+        stub(factoryMock) { mock in
+            when(mock.getDelegates(any(), appType: any(), startCounterName: any(), device: any(), config: any(), bbcUser: any()))
+                    .thenReturn([recording, mock1])
+        }
+    }
+
+    func makeDeferredClient(delay: TimeInterval = 60) -> EchoClient? {
+        return try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                               config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                               brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock, delegateConstructionDelay: delay)
+    }
+
+    func verifyFactoryCalled(_ times: Int) {
+        verify(factoryMock, Cuckoo.times(times)).getDelegates(any(), appType: any(), startCounterName: any(), device: any(),
+                                                              config: any(), bbcUser: any())
+    }
+
+    func testDelegatesAreNotConstructedDuringInit() {
+        let deferredClient = makeDeferredClient()
+
+        XCTAssertNotNil(deferredClient)
+        verifyFactoryCalled(0)
+    }
+
+    func testCallsBeforeTheFirstEventAreReplayedInOrder() {
+        let deferredClient = makeDeferredClient()!
+
+        deferredClient.addLabels(["a": "1", "b": "2"])
+        deferredClient.removeLabels(["a"])
+        deferredClient.setCounterName("news.page")
+        verifyFactoryCalled(0)
+
+        deferredClient.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        verifyFactoryCalled(1)
+        XCTAssertEqual(["start", "addLabels:a,b", "removeLabels:a", "setCounterName:news.page", "view:news.page"],
+                       recording.calls)
+        verify(mock1).viewEvent(counterName: "news.page", eventLabels: any())
+    }
+
+    func testCallsAfterConstructionGoStraightToTheDelegates() {
+        let deferredClient = makeDeferredClient()!
+        deferredClient.viewEvent(counterName: "first", eventLabels: nil)
+
+        deferredClient.setCounterName("second")
+        deferredClient.viewEvent(counterName: "second", eventLabels: nil)
+
+        verifyFactoryCalled(1)
+        XCTAssertEqual(2, deferredClient.delegates.count)
+        XCTAssertEqual(["start", "view:first", "setCounterName:second", "view:second"], recording.calls)
+    }
+
+    func testDelegatesAreConstructedAfterTheDelay() {
+        let deferredClient = makeDeferredClient(delay: 0.1)!
+        deferredClient.addLabels(["a": "1"])
+
+        let constructed = expectation(description: "constructed")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.3) {
+            constructed.fulfill()
+        }
+        wait(for: [constructed], timeout: 2)
+
+        verifyFactoryCalled(1)
+        XCTAssertEqual(["start", "addLabels:a"], recording.calls)
+    }
+
+    func testDelayCanBeConfigured() throws {
+        config[.echoDelegateConstructionDelay] = "60"
+        let configuredClient = try XCTUnwrap(try? EchoClient(appName: cleanAppName, appType: .mobileApp,
+                                                             startCounterName: startCounterName, config: config,
+                                                             echoDelegateFactory: factoryMock, device: deviceMock,
+                                                             brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock))
+        verifyFactoryCalled(0)
+
+        configuredClient.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        verifyFactoryCalled(1)
+    }
+
+    func testResultsConstructTheDelegates() {
+        let deferredClient = makeDeferredClient()!
+
+        _ = deferredClient.getComScoreDeviceID()
+
+        verifyFactoryCalled(1)
+    }
+
+    // MARK: - Startup
+
+    func makeClientWithSDKs(delegateConstructionDelay: TimeInterval?) -> EchoClient? {
+        return try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                               config: config, echoDelegateFactory: DefaultDelegateFactory(), device: EchoDevice(),
+                               brokerFactory: BrokerFactory(), bbcUser: BBCUser(),
+                               delegateConstructionDelay: delegateConstructionDelay)
+    }
+
+    func testPerformanceOfInitConstructingDelegates() {
+        measure {
+            XCTAssertNotNil(makeClientWithSDKs(delegateConstructionDelay: nil))
+        }
+    }
+
+    func testPerformanceOfInitDeferringDelegates() {
+        measure {
+            XCTAssertNotNil(makeClientWithSDKs(delegateConstructionDelay: 60))
+        }
+    }
+
+}
@@ -0,0 +1,252 @@
+//
+//  EchoClientEventLogTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import Cuckoo
+import XCTest
+@testable import Echo
+
+class EchoClientEventLogTests: EchoClientTests {
+
+    var directory: URL!
+    var eventLog: EchoEventLog!
+
+    /// Stands in for a delegate which reports back on its uploads, as the collector does
+    class AcknowledgingDelegate: EchoDelegateMock, EchoFlushTarget {
+        var outcome = EchoFlushOutcome.sent(bytes: 1)
+
+        func flush(completion: @escaping (EchoFlushOutcome) -> Void) {
+            completion(outcome)
+        }
+    }
+
+    /// Records the settings and labels in effect as each view event arrives
+    class SettingsRecordingDelegate: AcknowledgingDelegate {
+        struct State {
+            var producer: Producer?
+            var destination: Destination?
+            var language: String?
+            var labels = [String: String]()
+        }
+
+        var state = State()
+        var stateAtEvent = [String: State]()
+        var viewed = [String]()
+
+        override func setProducer(_ site: Producer) {
+            state.producer = site
+        }
+
+        override func setDestination(_ site: Destination) {
+            state.destination = site
+        }
+
+        override func setContentLanguage(_ language: String) {
+            state.language = language
+        }
+
+        override func addLabels(_ labels: [String: String]) {
+            state.labels.merge(labels) { _, new in new }
+        }
+
+        override func removeLabels(_ labels: [String]) {
+            labels.forEach { state.labels.removeValue(forKey: $0) }
+        }
+
+        override func viewEvent(counterName: String, eventLabels: [String: String]?) {
+            stateAtEvent[counterName] = state
+            viewed.append(counterName)
+        }
+    }
+
+    override func setUp() {
+        super.setUp()
+
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent("EchoClientEventLogTests-\(UUID().uuidString)", isDirectory: true)
+        eventLog = try? EchoEventLog(directory: directory)
+        client.eventLog = eventLog
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func testEventIsLoggedBeforeDispatch() {
+        var loggedBeforeDispatch = false
+        stub(mock1) { mock in
+            when(mock.viewEvent(counterName: any(), eventLabels: any())).then { _ in
+                loggedBeforeDispatch = self.eventLog.lastSequence == 1
+            }
+        }
+
+        client.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        XCTAssertTrue(loggedBeforeDispatch)
+        XCTAssertEqual(1, eventLog.deliveredThrough)
+    }
+
+    func testEventIsOnlyDeliveredOnceAcknowledged() {
+        client.delegates = [AcknowledgingDelegate()]
+
+        client.viewEvent(counterName: "news.page", eventLabels: nil)
+        XCTAssertEqual(1, eventLog.dispatchedThrough)
+        XCTAssertEqual(0, eventLog.deliveredThrough)
+
+        client.flushCache()
+
+        let delivered = expectation(for: NSPredicate { _, _ in self.eventLog.deliveredThrough == 1 }, evaluatedWith: nil)
+        wait(for: [delivered], timeout: 2)
+    }
+
+    /// As on the next launch, treats everything logged so far as from an earlier session
+    func relaunch() {
+        client.eventLog = eventLog
+    }
+
+    func testUndeliveredEventsAreReplayedToAcknowledgingDelegatesOnly() {
+        client.delegates = [AcknowledgingDelegate()]
+        client.viewEvent(counterName: "news.page", eventLabels: nil)
+        relaunch()
+
+        let acknowledging = SettingsRecordingDelegate()
+        client.replayUndeliveredEvents(to: [mock1, acknowledging])
+
+        verify(mock1, never()).viewEvent(counterName: any(), eventLabels: any())
+        XCTAssertEqual(["news.page"], acknowledging.viewed)
+        XCTAssertEqual(1, eventLog.dispatchedThrough)
+        XCTAssertEqual(0, eventLog.deliveredThrough)
+    }
+
+    func testEventsFromThisSessionAreNotReplayed() {
+        client.delegates = [AcknowledgingDelegate()]
+        client.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        let acknowledging = SettingsRecordingDelegate()
+        client.replayUndeliveredEvents(to: [acknowledging])
+
+        XCTAssertTrue(acknowledging.viewed.isEmpty)
+    }
+
+    func testEachEventReachesDeferredDelegatesOnce() throws {
+        // Left undelivered by an earlier session
+        client.delegates = [AcknowledgingDelegate()]
+        client.viewEvent(counterName: "earlier", eventLabels: nil)
+
+        let acknowledging = SettingsRecordingDelegate()
+        reset(factoryMock)
+        stub(factoryMock) { mock in
+            when(mock.getDelegates(any(), appType: any(), startCounterName: any(), device: any(), config: any(), bbcUser: any()))
+                    .thenReturn([acknowledging])
+        }
+        client = try XCTUnwrap(try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                                               config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                                               brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock,
+                                               delegateConstructionDelay: 60))
+        client.eventLog = eventLog
+
+        client.viewEvent(counterName: "first", eventLabels: nil)
+        client.viewEvent(counterName: "second", eventLabels: nil)
+
+        XCTAssertEqual(["earlier", "first", "second"], acknowledging.viewed)
+    }
+
+    func replay() -> SettingsRecordingDelegate {
+        relaunch()
+        let delegate = SettingsRecordingDelegate()
+        client.replayUndeliveredEvents(to: [delegate])
+        return delegate
+    }
+
+    func testReplayRestoresTheProducer() {
+        client.delegates = [AcknowledgingDelegate()]
+        client.setProducer(site: .Bitesize)
+        client.viewEvent(counterName: "first", eventLabels: nil)
+        client.setProducer(site: .Amharic)
+        client.viewEvent(counterName: "second", eventLabels: nil)
+
+        let delegate = replay()
+
+        XCTAssertEqual(.Bitesize, delegate.stateAtEvent["first"]?.producer)
+        XCTAssertEqual(.Amharic, delegate.stateAtEvent["second"]?.producer)
+        XCTAssertEqual(.Amharic, delegate.state.producer)
+    }
+
+    func testReplayRestoresTheDestination() {
+        client.delegates = [AcknowledgingDelegate()]
+        client.setDestination(site: .CBBC)
+        client.viewEvent(counterName: "first", eventLabels: nil)
+        client.setDestination(site: .CBBCTest)
+        client.viewEvent(counterName: "second", eventLabels: nil)
+
+        let delegate = replay()
+
+        XCTAssertEqual(.CBBC, delegate.stateAtEvent["first"]?.destination)
+        XCTAssertEqual(.CBBCTest, delegate.stateAtEvent["second"]?.destination)
+        XCTAssertEqual(.CBBCTest, delegate.state.destination)
+    }
+
+    func testReplayRestoresTheContentLanguage() {
+        client.delegates = [AcknowledgingDelegate()]
+        client.setContentLanguage("en-GB")
+        client.viewEvent(counterName: "first", eventLabels: nil)
+        client.setContentLanguage("cy")
+        client.viewEvent(counterName: "second", eventLabels: nil)
+
+        let delegate = replay()
+
+        XCTAssertEqual("en-GB", delegate.stateAtEvent["first"]?.language)
+        XCTAssertEqual("cy", delegate.stateAtEvent["second"]?.language)
+        XCTAssertEqual("cy", delegate.state.language)
+        XCTAssertTrue(delegate.state.labels.isEmpty)
+    }
+
+    func testReplayRestoresTheUserLabels() throws {
+        config[.idv5Enabled] = "true"
+        client = try XCTUnwrap(try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                                               config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                                               brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock))
+        client.eventLog = eventLog
+        client.delegates = [AcknowledgingDelegate()]
+
+        client.setBBCUser(BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date()))
+        client.viewEvent(counterName: "first", eventLabels: nil)
+        client.setBBCUser(BBCUser())
+        client.viewEvent(counterName: "second", eventLabels: nil)
+
+        let delegate = replay()
+
+        XCTAssertEqual("1", delegate.stateAtEvent["first"]?.labels[EchoLabelKeys.BBCIDLoggedIn.rawValue])
+        XCTAssertEqual("1234", delegate.stateAtEvent["first"]?.labels[EchoLabelKeys.BBCHashedID.rawValue])
+        XCTAssertNil(delegate.stateAtEvent["second"]?.labels[EchoLabelKeys.BBCIDLoggedIn.rawValue])
+        XCTAssertNil(delegate.stateAtEvent["second"]?.labels[EchoLabelKeys.BBCHashedID.rawValue])
+        XCTAssertNil(delegate.state.labels[EchoLabelKeys.BBCHashedID.rawValue])
+    }
+
+    func testLoggedEventCarriesSanitisedLabels() {
+        client.viewEvent(counterName: "news.page", eventLabels: dirtyLabelsIn)
+
+        var logged = [EchoEventRecord]()
+        eventLog.forEachRecord(after: 0) { _, record in logged.append(record) }
+
+        XCTAssertEqual(1, logged.count)
+        XCTAssertEqual(.view, logged[0].kind)
+        assertLabelsOutIncludeCleanedLabelsIn(labelsOut: logged[0].labels!)
+    }
+
+    func testClearCacheClearsEventLog() {
+        client.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        client.clearCache()
+
+        var count = 0
+        eventLog.forEachRecord(after: 0) { _, _ in count += 1 }
+        XCTAssertEqual(0, count)
+    }
+
+}
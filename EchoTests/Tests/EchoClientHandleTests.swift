@@ -0,0 +1,227 @@
+//
+//  EchoClientHandleTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import Cuckoo
+import XCTest
+@testable import Echo
+
+class EchoClientHandleTests: EchoClientTests {
+
+    class RecordingDelegate: EchoDelegateMock {
+        var calls = [String]()
+
+        override func addLabels(_ labels: [String: String]) {
+            calls.append("addLabels:\(labels.keys.sorted().joined(separator: ","))")
+        }
+
+        override func setCounterName(_ counterName: String) {
+            calls.append("setCounterName:\(counterName)")
+        }
+
+        override func viewEvent(counterName: String, eventLabels: [String: String]?) {
+            calls.append("view:\(counterName)")
+        }
+
+        override func userActionEvent(actionType: String, actionName: String, eventLabels: [String: String]?) {
+            calls.append("userAction:\(actionName)")
+        }
+    }
+
+    /// Notes whether the user state record was loaded on the main thread
+    class ThreadRecordingBackend: EchoUserStateBackend {
+        var loadedOnMain: Bool?
+
+        func load() -> Data? {
+            loadedOnMain = Thread.isMainThread
+            return nil
+        }
+
+        func save(_ data: Data) throws {
+        }
+
+        func remove() throws {
+        }
+    }
+
+    var recording: RecordingDelegate!
+    var backend: ThreadRecordingBackend!
+    var initialiserReleased: DispatchSemaphore!
+    var initialisedOnMain: Bool?
+    var deviceIDReadOnMain: Bool?
+
+    override func setUp() {
+        super.setUp()
+
+        recording = RecordingDelegate()
+        backend = ThreadRecordingBackend()
+        initialiserReleased = DispatchSemaphore(value: 0)
+        // The first read is the one made while preparing
+        stub(deviceMock) { mock in
+            when(mock.getDeviceID()).then {
+                if self.deviceIDReadOnMain == nil {
+                    self.deviceIDReadOnMain = Thread.isMainThread
+                }
+                return "prepared-device"
+            }
+        }
+        stub(factoryMock) { mock in
+            when(mock.getDelegates(any(), appType: any(), startCounterName: any(), device: any(), config: any(), bbcUser: any()))
+                    .thenReturn([recording])
+        }
+    }
+
+    /// A handle whose initialisation does not finish until `initialiserReleased` is signalled
+    func makeHandle(appName: String? = nil) -> EchoClientHandle {
+        let appName = appName ?? cleanAppName
+        return EchoClientHandle(queue: DispatchQueue(label: "EchoClientHandleTests"), prepare: { () -> EchoPreparedInitialisation in
+            self.initialiserReleased.wait()
+            return try self.prepare(appName: appName)
+        }, initialiser: { prepared in
+            self.initialisedOnMain = Thread.isMainThread
+            return try EchoClient(appName: appName, appType: .mobileApp, startCounterName: self.startCounterName,
+                                  config: self.config, echoDelegateFactory: self.factoryMock, device: self.deviceMock,
+                                  brokerFactory: self.brokerFactoryMock, bbcUser: self.bbcUserMock,
+                                  prepared: prepared)
+        })
+    }
+
+    func prepare(appName: String? = nil) throws -> EchoPreparedInitialisation {
+        return try EchoPreparedInitialisation(appName: appName ?? cleanAppName, config: config, device: deviceMock,
+                                              userStateStore: { EchoUserStateStore(backend: self.backend, legacyDefaults: nil) })
+    }
+
+    func waitUntilFinished(_ handle: EchoClientHandle) {
+        let finished = expectation(description: "finished")
+        handle.whenReady { _ in finished.fulfill() }
+        wait(for: [finished], timeout: 5)
+    }
+
+    func testHandleIsReturnedBeforeInitialisationFinishes() {
+        let handle = makeHandle()
+
+        handle.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        XCTAssertFalse(handle.isReady)
+        XCTAssertNil(handle.client)
+        XCTAssertEqual(1, handle.pendingCallCount)
+        XCTAssertTrue(recording.calls.isEmpty)
+
+        initialiserReleased.signal()
+        waitUntilFinished(handle)
+    }
+
+    func testEarlyCallsAreReplayedInOrder() {
+        let handle = makeHandle()
+
+        handle.addLabels(["a": "1"])
+        handle.setCounterName("news.page")
+        handle.viewEvent(counterName: "news.page", eventLabels: nil)
+        handle.userActionEvent(actionType: "click", actionName: "button", eventLabels: nil)
+
+        initialiserReleased.signal()
+        waitUntilFinished(handle)
+
+        XCTAssertTrue(handle.isReady)
+        XCTAssertEqual(0, handle.pendingCallCount)
+        // Anything Echo itself sends during initialisation comes first
+        XCTAssertEqual(["addLabels:a", "setCounterName:news.page", "view:news.page", "userAction:button"],
+                       Array(recording.calls.suffix(4)))
+    }
+
+    func testClientIsCreatedOnTheMainThread() {
+        let handle = makeHandle()
+        initialiserReleased.signal()
+        waitUntilFinished(handle)
+
+        XCTAssertEqual(true, initialisedOnMain)
+    }
+
+    func testUserStateAndDeviceIDAreReadOffTheMainThread() {
+        let handle = makeHandle()
+        initialiserReleased.signal()
+        waitUntilFinished(handle)
+
+        XCTAssertEqual(false, backend.loadedOnMain)
+        XCTAssertEqual(false, deviceIDReadOnMain)
+    }
+
+    func testCallsAfterReadyGoStraightToTheClient() {
+        let handle = makeHandle()
+        initialiserReleased.signal()
+        waitUntilFinished(handle)
+
+        handle.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        XCTAssertEqual(0, handle.pendingCallCount)
+        XCTAssertEqual("view:news.page", recording.calls.last)
+    }
+
+    func testCallsAreDroppedWhenInitialisationFails() {
+        let handle = makeHandle(appName: " ")
+        handle.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        initialiserReleased.signal()
+        var result: EchoClient?
+        let finished = expectation(description: "finished")
+        handle.whenReady { client in
+            result = client
+            finished.fulfill()
+        }
+        wait(for: [finished], timeout: 5)
+
+        XCTAssertNil(result)
+        XCTAssertNotNil(handle.error)
+        XCTAssertEqual(0, handle.pendingCallCount)
+        XCTAssertFalse(recording.calls.contains("view:news.page"))
+    }
+
+    // MARK: - Startup latency
+
+    func testPerformanceOfReturningAHandle() {
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            startMeasuring()
+            let handle = EchoClient.initialiseInBackground(appName: cleanAppName, appType: .mobileApp,
+                                                           startCounterName: startCounterName, config: config)
+            stopMeasuring()
+
+            waitUntilFinished(handle)
+        }
+    }
+
+    // The main thread's share of initialisation, without and with the reads `prepare` moves off it
+
+    func testPerformanceOfMainThreadInitialisation() {
+        measure {
+            _ = try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                                config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                                brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock)
+        }
+    }
+
+    func testPerformanceOfMainThreadInitialisationOncePrepared() {
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            let prepared = try? prepare()
+            XCTAssertNotNil(prepared)
+
+            startMeasuring()
+            _ = try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                                config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                                brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock, prepared: prepared)
+            stopMeasuring()
+        }
+    }
+
+    func testPerformanceOfBackgroundInitialisationUntilReady() {
+        measure {
+            let handle = EchoClient.initialiseInBackground(appName: cleanAppName, appType: .mobileApp,
+                                                           startCounterName: startCounterName, config: config)
+            waitUntilFinished(handle)
+        }
+    }
+
+}
@@ -272,4 +272,103 @@ class EchoClientLiveStreamingTests: EchoClientTests {
         let labels : [String:String] = labelsList[0]
         assert("false" == labels[EchoLabelKeys.ESSEnabled.rawValue])
     }
+
+    func testLiveTimestampLabelIsPushedToDelegatesAtAThrottledRate() {
+        reset(mock1)
+        reset(mockLiveBroker)
+        stub(mockLiveBroker) { mlb in
+            when(mlb.getPosition()).thenReturn(12345)
+        }
+
+        for second in 0..<20 {
+            client.liveTimestampUpdate(1455290000 + TimeInterval(second))
+        }
+
+        verify(mock1).addLabels(equal(to: [EchoLabelKeys.MediaTimestamp.rawValue: "1455290000000"]))
+        verify(mock1).addLabels(equal(to: [EchoLabelKeys.MediaTimestamp.rawValue: "1455290010000"]))
+        verify(mock1, times(2)).addLabels(any())
+        verify(mockLiveBroker, times(2)).getPosition()
+    }
+
+    func testLiveTimestampLabelIsRemovedWhenMediaIsReplaced() {
+        client.liveTimestampUpdate(1455290000)
+
+        client.setMedia(mediaLiveEpisode)
+
+        verify(mock1).removeLabels(equal(to: [EchoLabelKeys.MediaTimestamp.rawValue]))
+    }
+
+    func testMediaTimestampIsDerivedFromPositionWhenEventIsSent() {
+        client.liveTimestampUpdate(1455290000)
+
+        stub(mockLiveBroker) { mlb in
+            when(mlb.getPosition()).thenReturn(22345)
+        }
+
+        client.avPlayEvent(at: 0, eventLabels: nil)
+
+        verify(mock1).avPlayEvent(at: 22345, eventLabels: optionalDictionaryCaptor.capture())
+        XCTAssertEqual("1455290010000", optionalDictionaryCaptor.value!![EchoLabelKeys.MediaTimestamp.rawValue])
+    }
+
+    func testPlayEventAfterSeekCarriesNoStaleMediaTimestamp() {
+        client.liveTimestampUpdate(1455290000)
+        reset(mock1)
+        client.avSeekEvent(at: 0, eventLabels: nil)
+
+        client.avPlayEvent(at: 0, eventLabels: nil)
+
+        verify(mock1).avPlayEvent(at: 12345, eventLabels: optionalDictionaryCaptor.capture())
+        XCTAssertNil(optionalDictionaryCaptor.value??[EchoLabelKeys.MediaTimestamp.rawValue])
+        // The persistent label is dropped too, so vendor heartbeats and non-AV events do not carry it
+        verify(mock1).removeLabels(equal(to: [EchoLabelKeys.MediaTimestamp.rawValue]))
+        verify(mock1, never()).addLabels(any())
+    }
+
+    func testMediaTimestampLabelIsResampledOnPositionEvents() {
+        client.liveTimestampUpdate(1455290000)
+
+        stub(mockLiveBroker) { mlb in
+            when(mlb.getPosition()).thenReturn(22345)
+        }
+
+        client.avPlayEvent(at: 0, eventLabels: nil)
+
+        verify(mock1).addLabels(equal(to: [EchoLabelKeys.MediaTimestamp.rawValue: "1455290010000"]))
+    }
+
+    /// A client whose wall clock reads 1455290020, 20s ahead of the player timestamps the tests report
+    func makeClientWithClock() throws -> EchoClient {
+        let clock = MockClock()
+        clock.time = 1455290020
+        let clockedClient = try EchoClient(appName: dirtyAppName, appType: ApplicationType.mobileApp,
+                                           startCounterName: startCounterName, config: config,
+                                           echoDelegateFactory: factoryMock, device: deviceMock,
+                                           brokerFactory: mockBrokerFactory, bbcUser: bbcUserMock, clock: clock)
+        clockedClient.viewEvent(counterName: "news.page", eventLabels: nil)
+        clockedClient.setPlayerDelegate(mockPlayerDelegate)
+        clockedClient.setMedia(mediaLiveEpisode)
+        return clockedClient
+    }
+
+    func testHeartbeatCarriesLiveEdgeLatency() throws {
+        client = try makeClientWithClock()
+        client.liveTimestampUpdate(1455290000)
+
+        client.sendHeartbeat(withName: "echo_hb_60", position: 12345)
+
+        verify(mock1).avUserActionEvent(actionType: "echo_hb", actionName: "echo_hb_60", position: any(),
+                                        eventLabels: optionalDictionaryCaptor.capture())
+        XCTAssertEqual("20000", optionalDictionaryCaptor.value!![EchoLiveLabelKeys.LiveEdgeLatency.rawValue])
+    }
+
+    func testEndEventCarriesLiveEdgeLatency() throws {
+        client = try makeClientWithClock()
+        client.liveTimestampUpdate(1455290000)
+
+        client.avEndEvent(at: 0, eventLabels: nil)
+
+        verify(mock1).avEndEvent(at: any(), eventLabels: optionalDictionaryCaptor.capture())
+        XCTAssertNotNil(optionalDictionaryCaptor.value!![EchoLiveLabelKeys.LiveEdgeLatencyP95.rawValue])
+    }
 }
@@ -0,0 +1,85 @@
+//
+//  EchoClientUserLabelsTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import Cuckoo
+import XCTest
+@testable import Echo
+
+class EchoClientUserLabelsTests: EchoClientTests {
+
+    let signedIn = BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date())
+
+    var userClient: EchoClient!
+
+    override func setUp() {
+        super.setUp()
+
+        config[.idv5Enabled] = "true"
+        userClient = try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                                     config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                                     brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock)
+        userClient.setBBCUser(signedIn)
+        reset(mock1, mock2)
+    }
+
+    func testSettingAnUnchangedUserSkipsTheUpdate() {
+        userClient.setBBCUser(BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date()))
+
+        verify(mock1, never()).updateBBCUserLabels(any())
+        verify(mock2, never()).updateBBCUserLabels(any())
+    }
+
+    func testChangedHashedIDUpdatesEachDelegateOnce() {
+        let changed = BBCUser(signedIn: true, hashedID: "5678", tokenRefreshTimestamp: Date())
+
+        let updated = ArgumentCaptor<BBCUser>()
+
+        userClient.setBBCUser(changed)
+        verify(mock1).updateBBCUserLabels(updated.capture())
+        verify(mock2).updateBBCUserLabels(any())
+        XCTAssertEqual("5678", updated.value?.hashedID)
+
+        userClient.setBBCUser(changed)
+        verify(mock1, times(1)).updateBBCUserLabels(any())
+        verify(mock2, times(1)).updateBBCUserLabels(any())
+    }
+
+    func testExpiredTokenIsAChange() {
+        userClient.setBBCUser(BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date(timeIntervalSince1970: 1)))
+
+        verify(mock1).updateBBCUserLabels(any())
+    }
+
+    // MARK: - EchoUserLabels
+
+    func testEverythingChangesWithoutAPreviousUpdate() {
+        XCTAssertEqual(Set(EchoUserLabels.Field.allCases), EchoUserLabels(signedIn).changes(from: nil))
+    }
+
+    func testOnlyChangedFieldsAreReported() {
+        let before = EchoUserLabels(signedIn)
+        let personalisationOff = EchoUserLabels(BBCUser(signedIn: true))
+        let signedOut = EchoUserLabels(BBCUser())
+
+        XCTAssertTrue(EchoUserLabels(signedIn).changes(from: before).isEmpty)
+        XCTAssertTrue(personalisationOff.changes(from: before).isSuperset(of: [.hashedID, .personalisation]))
+        XCTAssertFalse(personalisationOff.changes(from: before).contains(.signedIn))
+        XCTAssertTrue(signedOut.changes(from: before).contains(.signedIn))
+    }
+
+    // MARK: - Performance
+
+    func testPerformanceOfSettingAnUnchangedUser() {
+        measure {
+            for _ in 0..<1_000 {
+                userClient.setBBCUser(signedIn)
+            }
+        }
+    }
+
+}
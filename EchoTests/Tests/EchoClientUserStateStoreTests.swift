@@ -0,0 +1,84 @@
+//
+//  EchoClientUserStateStoreTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import Cuckoo
+import XCTest
+@testable import Echo
+
+class EchoClientUserStateStoreTests: EchoClientTests {
+
+    var directory: URL!
+    var backend: EchoFileUserStateBackend!
+    var defaults: UserDefaults!
+    var store: EchoUserStateStore!
+    var userClient: EchoClient!
+
+    override func setUp() {
+        super.setUp()
+
+        directory = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString)
+        backend = EchoFileUserStateBackend(url: directory.appendingPathComponent("echo_user_state.json"))
+        UserDefaults().removePersistentDomain(forName: "clientUserStateDefaults")
+        defaults = UserDefaults(suiteName: "clientUserStateDefaults")
+        store = EchoUserStateStore(backend: backend, legacyDefaults: defaults, coalescingInterval: 60)
+
+        config[.idv5Enabled] = "true"
+        userClient = try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                                     config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                                     brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock, userStateStore: store)
+    }
+
+    override func tearDown() {
+        defaults.removePersistentDomain(forName: "clientUserStateDefaults")
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func testSettingAUserIsRecorded() {
+        let timestamp = Date()
+        userClient.setBBCUser(BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: timestamp))
+
+        XCTAssertTrue(store.state.signedIn)
+        XCTAssertEqual("1234", store.state.hashedID)
+        XCTAssertEqual(timestamp, store.state.tokenRefreshTimestamp)
+    }
+
+    func testRecordIsWrittenWhenBackgrounded() {
+        userClient.setBBCUser(BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date()))
+        XCTAssertNil(backend.load())
+
+        userClient.appBackgrounded()
+
+        XCTAssertNotNil(backend.load())
+        XCTAssertFalse(store.hasUnsavedChanges)
+    }
+
+    func testClearCacheKeepsTheUserState() {
+        userClient.setBBCUser(BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date()))
+        store.flush()
+
+        userClient.clearCache()
+
+        XCTAssertEqual("1234", store.state.hashedID)
+        XCTAssertNotNil(backend.load())
+    }
+
+    func testResettingUserDataClearsTheRecordButNotTheLegacyKeys() {
+        defaults.set("legacy-device", forKey: UserDefaultsKeys.echoDeviceID.rawValue)
+        let user = BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date())
+        userClient.setBBCUser(user)
+        store.flush()
+
+        userClient.resetUserData(user, .userStateChange)
+
+        XCTAssertEqual(EchoUserState(), store.state)
+        XCTAssertNil(backend.load())
+        XCTAssertEqual("legacy-device", defaults.string(forKey: UserDefaultsKeys.echoDeviceID.rawValue))
+    }
+
+}
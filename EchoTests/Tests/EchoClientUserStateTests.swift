@@ -52,13 +52,13 @@ class EchoClientUserStateTests: XCTestCase {
         client.start()
 
         reset(delegate)
-        client.setBBCUser(user)
+        client.setBBCUser(LoggedInPersonalisationOn)
         stub(echoDeviceMock) { stub in
             when(stub.getDeviceID()).thenReturn("some-device-id")
         }
 
         verify(delegate).updateBBCUserLabels(userCaptor.capture())
-        XCTAssertEqual(userCaptor.value, user)
+        XCTAssertEqual(userCaptor.value, LoggedInPersonalisationOn)
     }
 
     func testCustomEventSentWhenUserStateChangeOccurs() {
@@ -0,0 +1,269 @@
+//
+//  EchoCollectorDelegateTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoCollectorDelegateTests: XCTestCase {
+
+    override func tearDown() {
+        CollectorStandInServer.stop()
+        super.tearDown()
+    }
+
+    func makeDelegate(_ configure: (inout EchoCollectorBatcher.Configuration) -> Void = { _ in }) -> EchoCollectorDelegate {
+        var configuration = EchoCollectorBatcher.Configuration()
+        configuration.maxAge = 60
+        configuration.retryBaseDelay = 0.05
+        configure(&configuration)
+
+        let delegate = EchoCollectorDelegate(appName: "collector_test", collectorURL: CollectorStandInServer.url,
+                                             configuration: configuration)
+        delegate.start()
+        return delegate
+    }
+
+    func waitForEvents(_ count: Int, timeout: TimeInterval = 10) {
+        let deadline = Date(timeIntervalSinceNow: timeout)
+        while CollectorStandInServer.received.reduce(0, { $0 + $1.events.count }) < count && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+    }
+
+    func receivedNames() -> [String] {
+        return CollectorStandInServer.received.flatMap { $0.events }.compactMap { $0["counter"] as? String }
+    }
+
+    func testEventsAreBatchedBySize() {
+        CollectorStandInServer.start()
+        let delegate = makeDelegate { $0.maxEvents = 5 }
+
+        for index in 0..<12 {
+            delegate.viewEvent(counterName: "page.\(index)", eventLabels: nil)
+        }
+        delegate.flushCache()
+        waitForEvents(12)
+
+        XCTAssertEqual([5, 5, 2], CollectorStandInServer.received.map { $0.events.count })
+        XCTAssertEqual(3, delegate.statistics.requests)
+    }
+
+    func testPartialBatchIsSentAfterMaxAge() {
+        CollectorStandInServer.start()
+        let delegate = makeDelegate { $0.maxAge = 0.1 }
+
+        delegate.viewEvent(counterName: "page", eventLabels: nil)
+        waitForEvents(1, timeout: 2)
+
+        XCTAssertEqual(1, CollectorStandInServer.received.count)
+    }
+
+    func testFailedBatchesAreRetriedInOrder() {
+        var configuration = CollectorStandInServer.Configuration()
+        configuration.failFirstRequests = 3
+        CollectorStandInServer.start(configuration)
+        let delegate = makeDelegate { $0.maxEvents = 2 }
+
+        for index in 0..<6 {
+            delegate.viewEvent(counterName: "page.\(index)", eventLabels: nil)
+        }
+        waitForEvents(6)
+
+        XCTAssertEqual([1, 2, 3], CollectorStandInServer.received.map { $0.batch })
+        XCTAssertEqual((0..<6).map { "page.\($0)" }, receivedNames())
+        XCTAssertEqual(3, delegate.statistics.failedRequests)
+    }
+
+    func testBatchesCarryASessionPerLaunch() {
+        CollectorStandInServer.start()
+
+        // Each launch constructs its own delegate, and its batch sequence starts again at 1
+        for launch in 0..<2 {
+            let delegate = makeDelegate()
+            delegate.viewEvent(counterName: "launch.\(launch)", eventLabels: nil)
+            delegate.flushCache()
+            waitForEvents(launch + 1)
+        }
+
+        let received = CollectorStandInServer.received
+        XCTAssertEqual([1, 1], received.map { $0.batch })
+        XCTAssertNotNil(received.first?.session)
+        XCTAssertEqual(2, Set(received.compactMap { $0.session }).count)
+    }
+
+    func testBatchesAreHeldUntilFlushedInAllCacheMode() {
+        CollectorStandInServer.start()
+        let delegate = makeDelegate { $0.maxEvents = 1 }
+        delegate.setCacheMode(.all)
+
+        delegate.viewEvent(counterName: "held", eventLabels: nil)
+        delegate.waitUntilIdle()
+        XCTAssertEqual(0, delegate.statistics.requests)
+
+        delegate.flushCache()
+        waitForEvents(1)
+        XCTAssertEqual(["held"], receivedNames())
+    }
+
+    func testOfflineCacheModeSendsBatchesAsTheyFill() {
+        CollectorStandInServer.start()
+        let delegate = EchoCollectorDelegate(appName: "collector_test", collectorURL: CollectorStandInServer.url,
+                                             cacheMode: .all)
+        delegate.start()
+        delegate.setCacheMode(.offline)
+
+        delegate.viewEvent(counterName: "sent", eventLabels: nil)
+        delegate.flushCache()
+        waitForEvents(1)
+
+        XCTAssertEqual(.offline, delegate.getCacheMode())
+        XCTAssertEqual(["sent"], receivedNames())
+    }
+
+    func testCollectorIsConstructedFromConfig() throws {
+        let config: [EchoConfigKey: String] = [.echoCollectorURL: CollectorStandInServer.url.absoluteString]
+        let client = try EchoClient(appName: "collector_test", appType: .mobileApp, startCounterName: "start", config: config,
+                                    echoDelegateFactory: MockDefaultDelegateFactory().withEnabledSuperclassSpy(),
+                                    device: MockEchoDevice().withEnabledSuperclassSpy(),
+                                    brokerFactory: MockBrokerFactory().withEnabledSuperclassSpy(), bbcUser: BBCUser())
+
+        XCTAssertEqual(1, client.delegates.filter { $0 is EchoCollectorDelegate }.count)
+    }
+
+    func testNoCollectorWithoutConfig() throws {
+        let client = try EchoClient(appName: "collector_test", appType: .mobileApp, startCounterName: "start", config: nil,
+                                    echoDelegateFactory: MockDefaultDelegateFactory().withEnabledSuperclassSpy(),
+                                    device: MockEchoDevice().withEnabledSuperclassSpy(),
+                                    brokerFactory: MockBrokerFactory().withEnabledSuperclassSpy(), bbcUser: BBCUser())
+
+        XCTAssertFalse(client.delegates.contains { $0 is EchoCollectorDelegate })
+    }
+
+    func testRejectedBatchIsDropped() {
+        var configuration = CollectorStandInServer.Configuration()
+        configuration.failFirstRequests = 1
+        configuration.failureStatusCode = 400
+        CollectorStandInServer.start(configuration)
+        let delegate = makeDelegate { $0.maxEvents = 1 }
+
+        delegate.viewEvent(counterName: "bad", eventLabels: nil)
+        delegate.viewEvent(counterName: "good", eventLabels: nil)
+        waitForEvents(1)
+
+        XCTAssertEqual(["good"], receivedNames())
+        XCTAssertEqual(1, delegate.statistics.droppedBatches)
+    }
+
+    func testEventsCarryPersistentAndEventLabels() {
+        CollectorStandInServer.start()
+        let delegate = makeDelegate()
+
+        delegate.addLabels(["app_label": "a", "shared": "persistent"])
+        delegate.setPlayerName("player")
+        delegate.userActionEvent(actionType: "click", actionName: "button", eventLabels: ["shared": "event"])
+        delegate.flushCache()
+        waitForEvents(1)
+
+        let event = CollectorStandInServer.received.first?.events.first
+        let labels = event?["labels"] as? [String: String]
+        XCTAssertEqual("user_action", event?["event"] as? String)
+        XCTAssertEqual("click", event?["action_type"] as? String)
+        XCTAssertEqual("a", labels?["app_label"])
+        XCTAssertEqual("event", labels?["shared"])
+        XCTAssertEqual("player", labels?["player_name"])
+    }
+
+    func testNothingIsSentWhenDisabled() {
+        CollectorStandInServer.start()
+        let delegate = makeDelegate()
+
+        delegate.disable()
+        delegate.viewEvent(counterName: "page", eventLabels: nil)
+        delegate.flushCache()
+        delegate.waitUntilIdle()
+
+        XCTAssertEqual(0, delegate.statistics.events)
+    }
+
+    func testClearCacheDropsQueuedEvents() {
+        CollectorStandInServer.start()
+        let delegate = makeDelegate {
+            $0.maxEvents = 2
+            $0.holdUntilFlushed = true
+        }
+
+        for index in 0..<5 {
+            delegate.viewEvent(counterName: "old.\(index)", eventLabels: nil)
+        }
+        delegate.clearCache()
+        delegate.viewEvent(counterName: "new", eventLabels: nil)
+        delegate.flushCache()
+        waitForEvents(1)
+        delegate.waitUntilIdle()
+
+        XCTAssertEqual(["new"], receivedNames())
+        XCTAssertEqual(1, delegate.statistics.requests)
+    }
+
+    func testUserDataResetClearsQueuedEvents() throws {
+        CollectorStandInServer.start()
+        let delegate = makeDelegate { $0.holdUntilFlushed = true }
+        let client = try EchoClient(appName: "collector_test", appType: .mobileApp, startCounterName: "start", config: nil,
+                                    echoDelegateFactory: MockDefaultDelegateFactory().withEnabledSuperclassSpy(),
+                                    device: MockEchoDevice().withEnabledSuperclassSpy(),
+                                    brokerFactory: MockBrokerFactory().withEnabledSuperclassSpy(), bbcUser: BBCUser())
+        client.delegates = [delegate]
+        let user = BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date())
+
+        delegate.viewEvent(counterName: "before.reset", eventLabels: nil)
+        client.resetUserData(user, .userStateChange)
+        delegate.viewEvent(counterName: "after.reset", eventLabels: nil)
+        delegate.flushCache()
+        waitForEvents(1)
+        delegate.waitUntilIdle()
+
+        XCTAssertEqual(["after.reset"], receivedNames())
+    }
+
+    // A typical session of page views and a play-through with heartbeats, batched and per hit
+    func testRequestsAndBytesPerSessionAgainstPerHit() {
+        func runSession(maxEvents: Int) -> EchoCollectorBatcher.Statistics {
+            CollectorStandInServer.start()
+            let delegate = makeDelegate { $0.maxEvents = maxEvents }
+            delegate.addLabels(["bbc_site": "news", "app_name": "collector_test", "app_type": "mobile-app"])
+
+            for page in 0..<10 {
+                delegate.viewEvent(counterName: "news.story.\(page).page", eventLabels: nil)
+            }
+            delegate.avPlayEvent(at: 0, eventLabels: nil)
+            for minute in 1...30 {
+                delegate.avUserActionEvent(actionType: "echo_hb", actionName: "echo_hb_\(minute * 60)",
+                                           position: UInt64(minute * 60_000), eventLabels: nil)
+            }
+            delegate.avEndEvent(at: 1_800_000, eventLabels: nil)
+            delegate.flushCache()
+            waitForEvents(42)
+
+            return delegate.statistics
+        }
+
+        let perHit = runSession(maxEvents: 1)
+        let batched = runSession(maxEvents: 50)
+
+        let attachment = XCTAttachment(string: "Per hit \(perHit.requests) requests \(perHit.bytes) bytes, " +
+                                               "batched \(batched.requests) requests \(batched.bytes) bytes")
+        attachment.name = "Collector session"
+        attachment.lifetime = .keepAlways
+        add(attachment)
+
+        XCTAssertEqual(42, perHit.requests)
+        XCTAssertEqual(1, batched.requests)
+        XCTAssertLessThan(batched.bytes, perHit.bytes)
+    }
+
+}
@@ -0,0 +1,192 @@
+//
+//  EchoCompressionTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoCompressionTests: XCTestCase {
+
+    var directory: URL!
+
+    override func setUp() {
+        super.setUp()
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent("EchoCompressionTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() {
+        CollectorStandInServer.stop()
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    // Events shaped like a session of page views followed by a half hour play-through with heartbeats
+    func sessionEvents() -> [[String: Any]] {
+        let persistent = ["bbc_site": "news", "app_name": "news", "app_type": "mobile-app",
+                          EchoLabelKeys.PlayerName.rawValue: "smp", EchoLabelKeys.PlayerVersion.rawValue: "3.2.1",
+                          EchoLabelKeys.ESSEnabled.rawValue: "true", EchoLabelKeys.IsBackground.rawValue: "false"]
+        var events = [[String: Any]]()
+        var ts: UInt64 = 1455290000000
+
+        for page in 0..<10 {
+            ts += 15_000
+            events.append(["event": "view", "ts": ts, "app": "news", "counter": "news.story.\(34_000_000 + page).page",
+                           "device": "2f1ab0e5-5c2f-4b43-9b7e-0a2b5c7e4d21", "labels": persistent])
+        }
+        for minute in 1...30 {
+            ts += 60_000
+            var labels = persistent
+            labels[EchoLabelKeys.MediaTimestamp.rawValue] = String(ts)
+            events.append(["event": "av_user_action", "ts": ts, "app": "news", "counter": "news.live.page",
+                           "action_type": "echo_hb", "name": "echo_hb_\(minute * 60)", "position": minute * 60_000,
+                           "device": "2f1ab0e5-5c2f-4b43-9b7e-0a2b5c7e4d21", "labels": labels])
+        }
+        return events
+    }
+
+    func serialised(_ events: [[String: Any]]) -> [Data] {
+        return events.map { try! JSONSerialization.data(withJSONObject: $0, options: []) }
+    }
+
+    func testRoundTripWithAndWithoutDictionary() {
+        let payload = Data("{\"event\":\"view\",\"counter\":\"news.page\",\"labels\":{}}".utf8)
+
+        XCTAssertEqual(payload, EchoDeflate.decompress(EchoDeflate.compress(payload)!))
+        XCTAssertEqual(payload, EchoCompressionDictionary.collector.decompress(EchoCompressionDictionary.collector.compress(payload)!))
+    }
+
+    func testDictionaryIsRequiredToInflate() {
+        let compressed = EchoCompressionDictionary.collector.compress(Data("{\"event\":\"view\"}".utf8))!
+
+        XCTAssertNil(EchoDeflate.decompress(compressed))
+        XCTAssertNil(EchoDeflate.decompress(compressed, dictionary: Data("other".utf8)))
+    }
+
+    func testDictionariesAreFrozenAtTheirVersions() {
+        let frozen: [(EchoCompressionDictionary, version: Int, count: Int, crc: UInt32)] = [
+            (.collector, 1, 754, 0x06985B9C),
+            (.eventLog, 1, 521, 0x41F2AAE4)
+        ]
+
+        for (dictionary, version, count, crc) in frozen {
+            // A change to the bytes needs a new version, or payloads already deflated cannot be inflated
+            XCTAssertEqual(version, dictionary.version)
+            XCTAssertEqual(count, dictionary.data.count)
+            XCTAssertEqual(crc, CRC32.checksum(dictionary.data))
+        }
+    }
+
+    func testEventLogDictionaryMatchesEncodedRecords() {
+        let records = sessionEvents().map { event -> Data in
+            EchoEventRecord(kind: .avUserAction, name: event["name"] as? String ?? "", type: "echo_hb",
+                            position: UInt64(event["position"] as? Int ?? 0),
+                            labels: event["labels"] as? [String: String]).encoded()
+        }
+        let plain = records.reduce(0) { $0 + EchoDeflate.compress($1)!.count }
+        let collector = records.reduce(0) { $0 + EchoCompressionDictionary.collector.compress($1)!.count }
+        let eventLog = records.reduce(0) { $0 + EchoCompressionDictionary.eventLog.compress($1)!.count }
+
+        XCTAssertLessThan(eventLog, plain)
+        XCTAssertLessThan(eventLog, collector)
+    }
+
+    func testDictionaryImprovesSingleEventCompression() {
+        let events = serialised(sessionEvents())
+        let raw = events.reduce(0) { $0 + $1.count }
+        let plain = events.reduce(0) { $0 + EchoDeflate.compress($1)!.count }
+        let primed = events.reduce(0) { $0 + EchoCompressionDictionary.collector.compress($1)!.count }
+
+        attach("Per event: raw \(raw) bytes, deflate \(plain) bytes, deflate with dictionary \(primed) bytes")
+        XCTAssertLessThan(plain, raw)
+        XCTAssertLessThan(primed, plain)
+        XCTAssertLessThan(primed, raw / 2)
+    }
+
+    func testCompressedEventLogRoundTrip() throws {
+        var log: EchoEventLog? = try EchoEventLog(directory: directory, compressRecords: true)
+        for index in 1...20 {
+            log?.append(EchoEventRecord(kind: .view, name: "page.\(index)", labels: ["bbc_site": "news"]))
+        }
+        log?.commit()
+        log = nil
+
+        let reopened = try EchoEventLog(directory: directory)
+        reopened.append(EchoEventRecord(kind: .view, name: "uncompressed", labels: nil))
+
+        var names = [String]()
+        reopened.forEachRecord(after: 0) { _, record in names.append(record.name) }
+        XCTAssertEqual((1...20).map { "page.\($0)" } + ["uncompressed"], names)
+    }
+
+    func testCompressedBatchesReachCollector() {
+        CollectorStandInServer.start()
+        var configuration = EchoCollectorBatcher.Configuration()
+        configuration.compressBatches = true
+        let delegate = EchoCollectorDelegate(appName: "news", collectorURL: CollectorStandInServer.url, configuration: configuration)
+        delegate.start()
+
+        delegate.viewEvent(counterName: "news.page", eventLabels: ["bbc_site": "news"])
+        delegate.flushCache()
+
+        let deadline = Date(timeIntervalSinceNow: 10)
+        while CollectorStandInServer.received.isEmpty && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+
+        XCTAssertEqual("news.page", CollectorStandInServer.received.first?.events.first?["counter"] as? String)
+        XCTAssertLessThan(delegate.statistics.bytes, delegate.statistics.uncompressedBytes)
+    }
+
+    // MARK: - Ratio and CPU cost on a session
+
+    func attach(_ summary: String) {
+        let attachment = XCTAttachment(string: summary)
+        attachment.name = name
+        attachment.lifetime = .keepAlways
+        add(attachment)
+    }
+
+    func testRatioOfBatchedSession() {
+        let events = serialised(sessionEvents())
+        var batch = Data("{\"session\":\"\(UUID().uuidString)\",\"batch\":1,\"events\":[".utf8)
+        batch.append(contentsOf: events.joined(separator: Data(",".utf8)))
+        batch.append(Data("]}".utf8))
+
+        let plain = EchoDeflate.compress(batch)!.count
+        let primed = EchoCompressionDictionary.collector.compress(batch)!.count
+
+        attach("Batched session: raw \(batch.count) bytes, deflate \(plain) bytes, deflate with dictionary \(primed) bytes")
+        XCTAssertLessThan(plain, batch.count / 2)
+        XCTAssertLessThanOrEqual(primed, plain)
+    }
+
+    func testPerformanceOfCompressingSessionPerEvent() {
+        let events = serialised(sessionEvents())
+
+        measure {
+            for _ in 0..<25 {
+                for event in events {
+                    _ = EchoCompressionDictionary.collector.compress(event)
+                }
+            }
+        }
+    }
+
+    func testPerformanceOfDecompressingSessionPerEvent() {
+        let compressed = serialised(sessionEvents()).map { EchoCompressionDictionary.collector.compress($0)! }
+
+        measure {
+            for _ in 0..<25 {
+                for event in compressed {
+                    _ = EchoCompressionDictionary.collector.decompress(event)
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,172 @@
+//
+//  EchoConfigurationTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import XCTest
+@testable import Echo
+
+class EchoConfigurationTests: XCTestCase {
+
+    let appName = "echo-tests"
+
+    func testDefaultsAreTyped() throws {
+        let configuration = try EchoConfiguration(appName: appName, config: nil)
+
+        XCTAssertTrue(configuration.enabled)
+        XCTAssertTrue(configuration.autoStart)
+        XCTAssertNil(configuration.debugLevel)
+        XCTAssertEqual(.offline, configuration.cacheMode)
+        XCTAssertEqual("ess.api.bbci.co.uk", configuration.essURL)
+        XCTAssertFalse(configuration.useESS)
+        XCTAssertTrue(configuration.essHTTPSEnabled)
+        XCTAssertFalse(configuration.idv5Enabled)
+        XCTAssertFalse(configuration.eventLogEnabled)
+        XCTAssertNil(configuration.cachePolicy)
+        XCTAssertNil(configuration.delegateConstructionDelay)
+        XCTAssertFalse(configuration.delegateIsolationEnabled)
+        XCTAssertFalse(configuration.flushSchedulerEnabled)
+        XCTAssertNil(configuration.collectorURL)
+        XCTAssertNil(configuration.reportingProfile)
+    }
+
+    func testUserValuesOverrideDefaults() throws {
+        let configuration = try EchoConfiguration(appName: appName, config: [
+            .echoAutoStart: "false",
+            .echoCacheMode: "all",
+            .echoDebug: "info",
+            .idv5Enabled: "true",
+            .echoDeviceID: "device-1",
+            .echoEventLogEnabled: "true",
+            .echoCacheMaxBytes: "1048576",
+            .echoCacheEviction: "oldest_first",
+            .echoDelegateConstructionDelay: "2.5",
+            .echoDelegateIsolationEnabled: "true",
+            .echoFlushSchedulerEnabled: "true",
+            .echoCollectorURL: "https://collector.example.com/batches",
+            .essURL: ""
+        ])
+
+        XCTAssertFalse(configuration.autoStart)
+        XCTAssertEqual(.all, configuration.cacheMode)
+        XCTAssertEqual(.info, configuration.debugLevel)
+        XCTAssertTrue(configuration.idv5Enabled)
+        XCTAssertEqual("device-1", configuration.deviceID)
+        XCTAssertTrue(configuration.eventLogEnabled)
+        XCTAssertEqual(EchoCachePolicy(maxBytes: 1048576, eviction: .oldestFirst), configuration.cachePolicy)
+        XCTAssertEqual(2.5, configuration.delegateConstructionDelay)
+        XCTAssertTrue(configuration.delegateIsolationEnabled)
+        XCTAssertTrue(configuration.flushSchedulerEnabled)
+        XCTAssertEqual(URL(string: "https://collector.example.com/batches"), configuration.collectorURL)
+        // Empty values are ignored
+        XCTAssertEqual("ess.api.bbci.co.uk", configuration.essURL)
+    }
+
+    func testDelegateValuesIncludeProfileAndLibrary() throws {
+        let configuration = try EchoConfiguration(appName: appName, config: [.reportingProfile: "gnl"])
+
+        XCTAssertEqual(.GNL, configuration.reportingProfile?.profile)
+        XCTAssertEqual("20982512", configuration.values[.comScoreCustomerIDKey])
+        XCTAssertEqual("bd2a8394361ee741c8f79a2bbb532a06", configuration.values[.comScorePublisherSecret])
+        XCTAssertEqual(EchoClient.LibraryName, configuration.values[.measurementLibName])
+        XCTAssertEqual(EchoClient.LibraryVersion, configuration.values[.measurementLibVersion])
+    }
+
+    func testUserCannotOverrideLibraryValues() throws {
+        let configuration = try EchoConfiguration(appName: appName, config: [.measurementLibName: "other"])
+
+        XCTAssertEqual(EchoClient.LibraryName, configuration.values[.measurementLibName])
+    }
+
+    func testEveryProfileValueIsMerged() throws {
+        for profile in [EchoProfile.PublicService, .WorldService, .GNL] {
+            let expected = EchoReportingProfiles.getConfigForProfile(profile)
+            let configuration = try EchoConfiguration(appName: appName, config: [.reportingProfile: profile.rawValue])
+
+            XCTAssertEqual(profile, configuration.reportingProfile?.profile)
+            XCTAssertEqual(expected, configuration.reportingProfile?.values)
+            for (key, value) in expected {
+                XCTAssertEqual(value, configuration.values[key], "\(profile) \(key)")
+            }
+        }
+    }
+
+    func testInvalidValuesThrow() {
+        let invalid: [[EchoConfigKey: String]] = [
+            [.echoEnabled: "yes"],
+            [.echoCacheMode: "sometimes"],
+            [.comScoreDebugMode: "true"],
+            [.useESS: "1"],
+            [.barbEnabled: "no"],
+            [.echoDelegateConstructionDelay: "soon"],
+            [.echoDelegateConstructionDelay: "-1"],
+            [.echoDelegateIsolationEnabled: "yes"],
+            [.echoFlushSchedulerEnabled: "yes"],
+            [.echoCollectorURL: "collector"],
+            [.echoCollectorURL: "ftp://collector.example.com"]
+        ]
+
+        for config in invalid {
+            XCTAssertThrowsError(try EchoConfiguration(appName: appName, config: config), "\(config)")
+        }
+    }
+
+    func testMissingRequiredValueThrows() {
+        XCTAssertThrowsError(try EchoConfiguration(appName: appName, config: nil, defaults: []))
+    }
+
+    func testBlankAppNameThrows() {
+        XCTAssertThrowsError(try EchoConfiguration(appName: "", config: nil))
+        XCTAssertThrowsError(try EchoConfiguration(appName: " \t\n", config: nil))
+    }
+
+    // MARK: - Performance
+
+    let userConfig: [EchoConfigKey: String] = [
+        .reportingProfile: "publicservice",
+        .echoCacheMode: "all",
+        .idv5Enabled: "true",
+        .webviewCookiesEnabled: "true",
+        .comScoreEnabled: "true"
+    ]
+
+    func testPerformanceOfCompilingConfiguration() {
+        measure {
+            for _ in 0..<1_000 {
+                _ = try? EchoConfiguration(appName: appName, config: userConfig)
+            }
+        }
+    }
+
+    func testPerformanceOfReadingTypedFlags() throws {
+        let configuration = try EchoConfiguration(appName: appName, config: userConfig)
+        var count = 0
+
+        measure {
+            for _ in 0..<100_000 where configuration.idv5Enabled && configuration.webviewCookiesEnabled {
+                count += 1
+            }
+        }
+        XCTAssertGreaterThan(count, 0)
+    }
+
+    func testPerformanceOfReadingStringFlags() throws {
+        let values = try EchoConfiguration(appName: appName, config: userConfig).values
+        var count = 0
+
+        measure {
+            for _ in 0..<100_000 where values[.idv5Enabled] == "true" && values[.webviewCookiesEnabled] == "true" {
+                count += 1
+            }
+        }
+        XCTAssertGreaterThan(count, 0)
+    }
+
+    func testTypedFieldsAreCompact() {
+        // Everything the client reads fits in a few words; only the delegates' strings live on the heap
+        XCTAssertLessThanOrEqual(MemoryLayout<EchoConfiguration>.size, 160)
+    }
+
+}
@@ -0,0 +1,201 @@
+//
+//  EchoEventLogGroupCommitTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoEventLogGroupCommitTests: XCTestCase {
+
+    var directory: URL!
+
+    override func setUp() {
+        super.setUp()
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent("EchoEventLogGroupCommitTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func makeLog(in directory: URL? = nil, interval: TimeInterval = 60, maxRecords: Int = 1000) throws -> EchoEventLog {
+        return try EchoEventLog(directory: directory ?? self.directory,
+                                durability: .groupCommit(interval: interval, maxRecords: maxRecords))
+    }
+
+    func viewRecord(_ index: Int) -> EchoEventRecord {
+        // Fixed width names keep every frame the same size
+        return EchoEventRecord(kind: .view, timestamp: 1455290000 + TimeInterval(index),
+                               name: String(format: "page.%05d", index), labels: ["key": "value"])
+    }
+
+    var frameSize: Int {
+        return EchoEventLog.recordHeaderSize + viewRecord(0).encoded().count
+    }
+
+    func names(in log: EchoEventLog) -> [String] {
+        var names = [String]()
+        log.forEachRecord(after: 0) { _, record in names.append(record.name) }
+        return names
+    }
+
+    /**
+     Stands in for a crash part way through committing the last `groupBytes` written: the log is
+     committed and dropped, then its segment is cut back to the first `writtenBytes` of that group.
+     */
+    func simulateCrash(_ log: inout EchoEventLog?, in directory: URL? = nil, groupBytes: Int, writtenBytes: Int) throws {
+        log?.commit()
+        log = nil
+
+        let files = try FileManager.default.contentsOfDirectory(at: directory ?? self.directory,
+                                                                includingPropertiesForKeys: nil, options: [])
+        let segment = try XCTUnwrap(files.first { $0.pathExtension == EchoEventLog.segmentExtension })
+        let handle = try FileHandle(forWritingTo: segment)
+        let size = handle.seekToEndOfFile()
+        handle.truncateFile(atOffset: size - UInt64(groupBytes - writtenBytes))
+        handle.closeFile()
+    }
+
+    func waitUntil(timeout: TimeInterval, _ condition: () -> Bool) {
+        let deadline = Date(timeIntervalSinceNow: timeout)
+        while !condition() && Date() < deadline {
+            Thread.sleep(forTimeInterval: 0.005)
+        }
+    }
+
+    func testGroupIsCommittedWithinItsInterval() throws {
+        let log = try makeLog(interval: 0.05)
+
+        for index in 0..<10 {
+            log.append(viewRecord(index))
+        }
+        let appended = Date()
+        XCTAssertEqual(0, log.committedThrough)
+
+        waitUntil(timeout: 2) { log.committedThrough == 10 }
+
+        XCTAssertEqual(10, log.committedThrough)
+        XCTAssertLessThan(Date().timeIntervalSince(appended), 1)
+    }
+
+    func testFullGroupIsCommittedWithoutWaitingForItsInterval() throws {
+        let log = try makeLog(interval: 60, maxRecords: 10)
+
+        for index in 0..<10 {
+            log.append(viewRecord(index))
+        }
+
+        waitUntil(timeout: 2) { log.committedThrough == 10 }
+        XCTAssertEqual(10, log.committedThrough)
+    }
+
+    func testPendingRecordsAreReadable() throws {
+        let log = try makeLog()
+
+        for index in 0..<5 {
+            log.append(viewRecord(index))
+        }
+
+        XCTAssertEqual((0..<5).map { viewRecord($0).name }, names(in: log))
+    }
+
+    func testCrashMidGroupRecoversEveryWholeRecord() throws {
+        var log: EchoEventLog? = try makeLog()
+        for index in 0..<20 {
+            log!.append(viewRecord(index))
+        }
+        log!.commit()
+        for index in 20..<30 {
+            log!.append(viewRecord(index))
+        }
+
+        // Four and a half records of the second group reach the disk
+        try simulateCrash(&log, groupBytes: frameSize * 10, writtenBytes: frameSize * 9 / 2)
+
+        let recovered = try makeLog()
+        XCTAssertEqual(24, recovered.lastSequence)
+        XCTAssertEqual(1, recovered.truncatedSegments)
+        XCTAssertEqual((0..<24).map { viewRecord($0).name }, names(in: recovered))
+        XCTAssertEqual(25, recovered.append(viewRecord(24)))
+    }
+
+    func testCrashAtAnyPointInAGroupLeavesAConsistentPrefix() throws {
+        let groupBytes = frameSize * 10
+
+        for cut in stride(from: 0, through: groupBytes, by: 13) {
+            let directory = self.directory.appendingPathComponent("cut-\(cut)", isDirectory: true)
+
+            var log: EchoEventLog? = try makeLog(in: directory)
+            for index in 0..<20 {
+                log!.append(viewRecord(index))
+            }
+            log!.commit()
+            for index in 20..<30 {
+                log!.append(viewRecord(index))
+            }
+            try simulateCrash(&log, in: directory, groupBytes: groupBytes, writtenBytes: cut)
+
+            let recovered = try makeLog(in: directory)
+            let expected = 20 + cut / frameSize
+            XCTAssertEqual(UInt64(expected), recovered.lastSequence, "cut at \(cut)")
+            XCTAssertEqual((0..<expected).map { viewRecord($0).name }, names(in: recovered), "cut at \(cut)")
+            XCTAssertEqual(cut % frameSize == 0 ? 0 : 1, recovered.truncatedSegments, "cut at \(cut)")
+            XCTAssertEqual(cut % frameSize, recovered.truncatedBytes, "cut at \(cut)")
+        }
+    }
+
+    func testCommittedRecordsAreNotLostByACrash() throws {
+        var log: EchoEventLog? = try makeLog(interval: 0.01)
+        for index in 0..<50 {
+            log!.append(viewRecord(index))
+        }
+        waitUntil(timeout: 2) { log!.committedThrough == 50 }
+        try simulateCrash(&log, groupBytes: 0, writtenBytes: 0)
+
+        XCTAssertEqual(50, try makeLog().lastSequence)
+    }
+
+    // MARK: - Throughput
+
+    func measureAppending(_ durability: EchoEventLog.Durability, count: Int = 10_000) {
+        let records = (0..<count).map { viewRecord($0) }
+
+        measure {
+            let directory = self.directory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+            guard let log = try? EchoEventLog(directory: directory, durability: durability) else {
+                return XCTFail("Unable to open event log")
+            }
+            for record in records {
+                log.append(record)
+            }
+            log.commit()
+        }
+    }
+
+    func testPerformanceOfCheckpointedAppends() {
+        measureAppending(.checkpointed)
+    }
+
+    func testPerformanceOfSyncingEveryRecord() {
+        measureAppending(.groupCommit(interval: 0, maxRecords: 1), count: 1_000)
+    }
+
+    func testPerformanceOfGroupCommitEvery1ms() {
+        measureAppending(.groupCommit(interval: 0.001, maxRecords: 64))
+    }
+
+    func testPerformanceOfGroupCommitEvery10ms() {
+        measureAppending(.groupCommit(interval: 0.01, maxRecords: 256))
+    }
+
+    func testPerformanceOfGroupCommitEvery100ms() {
+        measureAppending(.groupCommit(interval: 0.1, maxRecords: 1024))
+    }
+
+}
@@ -0,0 +1,229 @@
+//
+//  EchoEventLogTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoEventLogTests: XCTestCase {
+
+    var directory: URL!
+
+    class RecordingDelegate: EchoDelegateMock {
+        var events = [String]()
+
+        override func viewEvent(counterName: String, eventLabels: [String: String]?) {
+            events.append("view:\(counterName)")
+        }
+
+        override func avSeekEvent(at position: UInt64, eventLabels: [String: String]?) {
+            events.append("seek:\(position)")
+        }
+    }
+
+    override func setUp() {
+        super.setUp()
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent("EchoEventLogTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func viewRecord(_ index: Int) -> EchoEventRecord {
+        return EchoEventRecord(kind: .view, timestamp: 1455290000 + TimeInterval(index), name: "page.\(index)",
+                               labels: ["key": "value \(index)"])
+    }
+
+    func records(in log: EchoEventLog, after sequence: UInt64 = 0) -> [EchoEventRecord] {
+        var records = [EchoEventRecord]()
+        log.forEachRecord(after: sequence) { _, record in records.append(record) }
+        return records
+    }
+
+    func segmentURLs() -> [URL] {
+        let files = (try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil, options: [])) ?? []
+        return files.filter { $0.pathExtension == EchoEventLog.segmentExtension }
+                .sorted { $0.lastPathComponent < $1.lastPathComponent }
+    }
+
+    func testRecordRoundTrip() {
+        let record = EchoEventRecord(kind: .avFastForward, timestamp: 12.5, name: "name", type: "type",
+                                     position: 1234, rate: 4, labels: ["a": "1", "b": "ü"])
+        let noLabels = EchoEventRecord(kind: .avPlay, position: 5, labels: nil)
+
+        XCTAssertEqual(record, EchoEventRecord(encoded: record.encoded()))
+        XCTAssertEqual(noLabels, EchoEventRecord(encoded: noLabels.encoded()))
+        XCTAssertNil(EchoEventRecord(encoded: record.encoded().prefix(10)))
+    }
+
+    func testAppendedRecordsAreReadBackInOrder() throws {
+        let log = try EchoEventLog(directory: directory)
+
+        for index in 1...10 {
+            XCTAssertEqual(UInt64(index), log.append(viewRecord(index)))
+        }
+
+        XCTAssertEqual((1...10).map(viewRecord), records(in: log))
+        XCTAssertEqual((6...10).map(viewRecord), records(in: log, after: 5))
+    }
+
+    func testLogIsRecoveredWhenReopened() throws {
+        var log: EchoEventLog? = try EchoEventLog(directory: directory)
+        for index in 1...10 {
+            log?.append(viewRecord(index))
+        }
+        log?.commit()
+        log = nil
+
+        let reopened = try EchoEventLog(directory: directory)
+
+        XCTAssertEqual(10, reopened.lastSequence)
+        XCTAssertEqual(11, reopened.append(viewRecord(11)))
+        XCTAssertEqual((1...11).map(viewRecord), records(in: reopened))
+    }
+
+    func testTornTailIsTruncatedOnRecovery() throws {
+        var log: EchoEventLog? = try EchoEventLog(directory: directory)
+        for index in 1...10 {
+            log?.append(viewRecord(index))
+        }
+        log?.commit()
+        log = nil
+
+        let segment = segmentURLs().last!
+        let handle = try FileHandle(forWritingTo: segment)
+        let size = handle.seekToEndOfFile()
+        handle.truncateFile(atOffset: size - 3)
+        handle.closeFile()
+
+        let reopened = try EchoEventLog(directory: directory)
+
+        XCTAssertEqual(9, reopened.lastSequence)
+        XCTAssertEqual(1, reopened.truncatedSegments)
+        XCTAssertEqual(10, reopened.append(viewRecord(10)))
+        XCTAssertEqual((1...10).map(viewRecord), records(in: reopened))
+    }
+
+    func testCorruptRecordFailsChecksum() throws {
+        var log: EchoEventLog? = try EchoEventLog(directory: directory)
+        for index in 1...10 {
+            log?.append(viewRecord(index))
+        }
+        log?.commit()
+        log = nil
+
+        let segment = segmentURLs().last!
+        var data = try Data(contentsOf: segment)
+        data[data.count - 2] ^= 0xFF
+        try data.write(to: segment)
+
+        let reopened = try EchoEventLog(directory: directory)
+
+        XCTAssertEqual(9, reopened.lastSequence)
+        XCTAssertEqual((1...9).map(viewRecord), records(in: reopened))
+    }
+
+    func testSegmentsRotateAndDeliveredSegmentsAreRemoved() throws {
+        let log = try EchoEventLog(directory: directory, segmentSize: 512)
+
+        for index in 1...100 {
+            log.append(viewRecord(index))
+        }
+        log.commit()
+        let segmentCount = segmentURLs().count
+        XCTAssertGreaterThan(segmentCount, 2)
+
+        log.markDelivered(through: 90)
+        log.checkpoint()
+
+        XCTAssertLessThan(segmentURLs().count, segmentCount)
+        XCTAssertEqual((91...100).map(viewRecord), records(in: log, after: 90))
+    }
+
+    func testDeliveryCursorSurvivesReopen() throws {
+        var log: EchoEventLog? = try EchoEventLog(directory: directory)
+        for index in 1...10 {
+            log?.append(viewRecord(index))
+        }
+        log?.markDelivered(through: 7)
+        log?.checkpoint()
+        log = nil
+
+        let reopened = try EchoEventLog(directory: directory)
+        let delegate = RecordingDelegate()
+
+        reopened.replayUndelivered(to: [delegate])
+
+        XCTAssertEqual(["view:page.8", "view:page.9", "view:page.10"], delegate.events)
+        XCTAssertEqual(7, reopened.deliveredThrough)
+        XCTAssertEqual(10, reopened.dispatchedThrough)
+    }
+
+    func testReplayGoesToAnyDelegate() throws {
+        let log = try EchoEventLog(directory: directory)
+        log.append(viewRecord(1))
+        log.append(EchoEventRecord(kind: .avSeek, position: 3000, labels: nil))
+
+        let first = RecordingDelegate()
+        let second = RecordingDelegate()
+        log.replayUndelivered(to: [first, second])
+
+        XCTAssertEqual(["view:page.1", "seek:3000"], first.events)
+        XCTAssertEqual(first.events, second.events)
+    }
+
+    func testClearRemovesAllRecords() throws {
+        let log = try EchoEventLog(directory: directory)
+        log.append(viewRecord(1))
+
+        log.clear()
+
+        XCTAssertTrue(records(in: log).isEmpty)
+        XCTAssertTrue(segmentURLs().isEmpty)
+    }
+
+    // MARK: - Benchmarks on a 100k event log
+
+    func fillLog(_ count: Int) throws {
+        let log = try EchoEventLog(directory: directory)
+        for index in 1...count {
+            log.append(viewRecord(index))
+        }
+        log.checkpoint()
+    }
+
+    func testPerformanceOfAppending100kEvents() {
+        measure {
+            try? FileManager.default.removeItem(at: directory)
+            try? fillLog(100_000)
+        }
+    }
+
+    func testPerformanceOfRecovering100kEventLog() throws {
+        try fillLog(100_000)
+
+        measure {
+            let log = try? EchoEventLog(directory: directory)
+            XCTAssertEqual(100_000, log?.lastSequence)
+        }
+    }
+
+    func testPerformanceOfReplaying100kEventLog() throws {
+        try fillLog(100_000)
+        let log = try EchoEventLog(directory: directory)
+
+        measure {
+            var count = 0
+            log.forEachRecord(after: 0) { _, _ in count += 1 }
+            XCTAssertEqual(100_000, count)
+        }
+    }
+
+}
@@ -0,0 +1,349 @@
+//
+//  EchoFlushSchedulerTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import UIKit
+import Cuckoo
+import XCTest
+@testable import Echo
+
+class EchoFlushSchedulerTests: XCTestCase {
+
+    /// Counts background tasks rather than asking an application, which the tests do not run in
+    class BackgroundTasks: BackgroundTaskSource {
+        private let lock = NSLock()
+        private var begun = 0
+        private var ended = Set<Int>()
+
+        var counts: (begun: Int, ended: Int) {
+            lock.lock()
+            defer { lock.unlock() }
+            return (begun, ended.count)
+        }
+
+        func begin(_ name: String, expiration: @escaping () -> Void) -> UIBackgroundTaskIdentifier {
+            lock.lock()
+            defer { lock.unlock() }
+            begun += 1
+            return UIBackgroundTaskIdentifier(rawValue: begun)
+        }
+
+        func end(_ task: UIBackgroundTaskIdentifier) {
+            lock.lock()
+            ended.insert(task.rawValue)
+            lock.unlock()
+        }
+    }
+
+    var reachability: SimulatedReachability!
+    var backgroundTasks: BackgroundTasks!
+
+    override func setUp() {
+        super.setUp()
+        reachability = SimulatedReachability()
+        backgroundTasks = BackgroundTasks()
+    }
+
+    override func tearDown() {
+        CollectorStandInServer.stop()
+        super.tearDown()
+    }
+
+    func makeCollector(holdUntilFlushed: Bool = true) -> EchoCollectorDelegate {
+        var configuration = EchoCollectorBatcher.Configuration()
+        configuration.maxEvents = 5
+        configuration.maxAge = 60
+        configuration.retryBaseDelay = 60
+        configuration.holdUntilFlushed = holdUntilFlushed
+
+        let delegate = EchoCollectorDelegate(appName: "flush_test", collectorURL: CollectorStandInServer.url,
+                                             configuration: configuration)
+        delegate.start()
+        return delegate
+    }
+
+    func makeScheduler(_ targets: [EchoFlushTarget], window: TimeInterval = 0.1) -> EchoFlushScheduler {
+        var configuration = EchoFlushScheduler.Configuration()
+        configuration.window = window
+        configuration.leeway = 0
+        configuration.backgroundBudget = 0.2
+        return EchoFlushScheduler(targets: targets, reachability: reachability, configuration: configuration,
+                                  backgroundTasks: backgroundTasks)
+    }
+
+    func sendViews(_ count: Int, to delegate: EchoCollectorDelegate) {
+        for index in 0..<count {
+            delegate.viewEvent(counterName: "page.\(index)", eventLabels: nil)
+        }
+        delegate.waitUntilIdle()
+    }
+
+    func wait(_ interval: TimeInterval, until condition: () -> Bool = { false }) {
+        let deadline = Date(timeIntervalSinceNow: interval)
+        while !condition() && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+    }
+
+    func receivedEvents() -> Int {
+        return CollectorStandInServer.received.reduce(0) { $0 + $1.events.count }
+    }
+
+    func testHeldBatchesAreSentInTheNextWindow() {
+        CollectorStandInServer.start()
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector], window: 0.3)
+
+        sendViews(10, to: collector)
+        XCTAssertEqual(0, CollectorStandInServer.requestCount)
+
+        scheduler.start()
+        wait(2) { scheduler.statistics.successes >= 1 }
+
+        let statistics = scheduler.statistics
+        XCTAssertEqual(10, receivedEvents())
+        XCTAssertEqual(2, CollectorStandInServer.requestCount)
+        XCTAssertGreaterThanOrEqual(statistics.attempts, 1)
+        XCTAssertEqual(collector.statistics.bytes, statistics.bytes)
+        XCTAssertGreaterThan(statistics.lastLatency, 0)
+    }
+
+    func testNothingIsSentWhileOffline() {
+        CollectorStandInServer.start()
+        reachability.set(reachable: false)
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector])
+        scheduler.start()
+
+        sendViews(5, to: collector)
+        wait(0.5)
+
+        XCTAssertEqual(0, CollectorStandInServer.requestCount)
+        XCTAssertEqual(0, scheduler.statistics.attempts)
+        XCTAssertGreaterThanOrEqual(scheduler.statistics.skippedOffline, 1)
+    }
+
+    func testReturningOnlineFlushesStraightAway() {
+        CollectorStandInServer.start()
+        reachability.set(reachable: false)
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector], window: 60)
+        scheduler.start()
+        sendViews(5, to: collector)
+
+        reachability.set(reachable: true)
+        wait(2) { scheduler.statistics.successes == 1 }
+
+        XCTAssertEqual(5, receivedEvents())
+        XCTAssertEqual(1, scheduler.statistics.successes)
+    }
+
+    func testRepeatedFailuresBackOff() {
+        var server = CollectorStandInServer.Configuration()
+        server.failFirstRequests = Int.max
+        CollectorStandInServer.start(server)
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector])
+
+        sendViews(5, to: collector)
+        scheduler.start()
+        wait(1.6)
+
+        // Without backoff a 0.1s window would allow around 16 attempts
+        let statistics = scheduler.statistics
+        XCTAssertGreaterThanOrEqual(statistics.failures, 2)
+        XCTAssertLessThanOrEqual(statistics.attempts, 6)
+        XCTAssertEqual(0, statistics.successes)
+    }
+
+    func testBackoffIsResetBySuccess() {
+        var server = CollectorStandInServer.Configuration()
+        server.failFirstRequests = 2
+        CollectorStandInServer.start(server)
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector])
+
+        sendViews(5, to: collector)
+        scheduler.start()
+        wait(3) { scheduler.statistics.successes >= 1 }
+
+        XCTAssertEqual(5, receivedEvents())
+        XCTAssertEqual(2, scheduler.statistics.failures)
+        XCTAssertGreaterThanOrEqual(scheduler.statistics.successes, 1)
+    }
+
+    func testBackgroundFlushReportsBackWithinItsBudget() {
+        var server = CollectorStandInServer.Configuration()
+        server.latency = 2
+        CollectorStandInServer.start(server)
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector], window: 60)
+        sendViews(5, to: collector)
+
+        var completed = false
+        let started = Date()
+        scheduler.flushWithinBudget { completed = true }
+        wait(1) { completed }
+
+        XCTAssertTrue(completed)
+        XCTAssertLessThan(Date().timeIntervalSince(started), 1)
+        XCTAssertEqual(1, scheduler.statistics.timedOut)
+    }
+
+    func testBackgroundFlushIsSkippedWhileOffline() {
+        CollectorStandInServer.start()
+        reachability.set(reachable: false)
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector], window: 60)
+        sendViews(5, to: collector)
+
+        var completed = false
+        scheduler.flushWithinBudget { completed = true }
+        wait(1) { completed }
+
+        XCTAssertTrue(completed)
+        XCTAssertEqual(0, CollectorStandInServer.requestCount)
+        XCTAssertEqual(1, scheduler.statistics.skippedOffline)
+        XCTAssertEqual(1, backgroundTasks.counts.ended)
+    }
+
+    func testBackgroundFlushHoldsABackgroundTaskUntilItReportsBack() {
+        CollectorStandInServer.start()
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector], window: 60)
+        sendViews(5, to: collector)
+
+        var completed = false
+        scheduler.flushWithinBudget { completed = true }
+        XCTAssertEqual(1, backgroundTasks.counts.begun)
+        wait(1) { completed }
+
+        XCTAssertTrue(completed)
+        XCTAssertEqual(1, backgroundTasks.counts.ended)
+    }
+
+    func testWindowsKeepOpeningWhileOffline() {
+        reachability.set(reachable: false)
+        let scheduler = makeScheduler([EchoDelegateFlushTarget(MockEchoDelegateMock().withEnabledSuperclassSpy())])
+        scheduler.start()
+
+        wait(1) { scheduler.statistics.skippedOffline >= 3 }
+
+        XCTAssertGreaterThanOrEqual(scheduler.statistics.skippedOffline, 3)
+        XCTAssertEqual(0, scheduler.statistics.attempts)
+    }
+
+    func testVendorDelegatesAreFlushedEachWindow() {
+        let vendor = MockEchoDelegateMock().withEnabledSuperclassSpy()
+        let scheduler = makeScheduler([EchoDelegateFlushTarget(vendor)])
+        scheduler.start()
+
+        wait(1) { scheduler.statistics.attempts >= 2 }
+
+        verify(vendor, atLeast(2)).flushCache()
+        XCTAssertEqual(0, scheduler.statistics.failures)
+    }
+
+    func testVendorDelegatesAreFlushedOnTheMainThread() {
+        let vendor = MockEchoDelegateMock().withEnabledSuperclassSpy()
+        var onMain: Bool?
+        stub(vendor) { stub in
+            when(stub.flushCache()).then { onMain = Thread.isMainThread }
+        }
+        let scheduler = makeScheduler([EchoDelegateFlushTarget(vendor)])
+        scheduler.start()
+
+        wait(1) { onMain != nil }
+
+        XCTAssertEqual(true, onMain)
+    }
+
+    func testBackgroundFlushDuringAFlushIsFollowedByAnother() {
+        var server = CollectorStandInServer.Configuration()
+        server.latency = 0.3
+        CollectorStandInServer.start(server)
+        let collector = makeCollector()
+        let scheduler = makeScheduler([collector], window: 60)
+        sendViews(5, to: collector)
+
+        scheduler.flushWithinBudget()
+        wait(1) { CollectorStandInServer.requestCount >= 1 }
+        // Sent once the first flush is under way, so only a further flush covers them
+        sendViews(5, to: collector)
+        var completed = false
+        scheduler.flushWithinBudget(2) { completed = true }
+        wait(3) { completed }
+
+        XCTAssertTrue(completed)
+        XCTAssertEqual(2, scheduler.statistics.attempts)
+        XCTAssertEqual(2, scheduler.statistics.successes)
+        XCTAssertEqual(10, receivedEvents())
+    }
+
+    func testIsolatedCollectorReportsItsUploads() {
+        CollectorStandInServer.start()
+        let collector = makeCollector()
+        let isolated: EchoDelegate = IsolatedDelegate(collector)
+        let target = isolated as? EchoFlushTarget
+        XCTAssertNotNil(target)
+        let scheduler = makeScheduler(target.map { [$0] } ?? [], window: 0.3)
+
+        sendViews(5, to: collector)
+        scheduler.start()
+        wait(2) { scheduler.statistics.successes >= 1 }
+
+        XCTAssertEqual(5, receivedEvents())
+        XCTAssertEqual(collector.statistics.bytes, scheduler.statistics.bytes)
+    }
+
+    // MARK: - Client
+
+    func makeClient(config: [EchoConfigKey: String]?, delegates: [EchoDelegate]) throws -> EchoClient {
+        let factory = MockDefaultDelegateFactory().withEnabledSuperclassSpy()
+        stub(factory) { mock in
+            when(mock.getDelegates(any(), appType: any(), startCounterName: any(), device: any(), config: any(), bbcUser: any()))
+                    .thenReturn(delegates)
+        }
+        return try EchoClient(appName: "flush_test", appType: .mobileApp, startCounterName: "start", config: config,
+                              echoDelegateFactory: factory, device: MockEchoDevice().withEnabledSuperclassSpy(),
+                              brokerFactory: MockBrokerFactory().withEnabledSuperclassSpy(), bbcUser: BBCUser())
+    }
+
+    func testClientStartsTheSchedulerFromConfig() throws {
+        let vendor = MockEchoDelegateMock().withEnabledSuperclassSpy()
+        let client = try makeClient(config: [.echoFlushSchedulerEnabled: "true"], delegates: [vendor])
+        let scheduler = try XCTUnwrap(client.flushScheduler)
+
+        client.appBackgrounded()
+        wait(2) { scheduler.statistics.attempts + scheduler.statistics.skippedOffline >= 1 }
+
+        // Whether the device is online decides which, but backgrounding either flushes or skips the flush
+        let statistics = scheduler.statistics
+        XCTAssertEqual(1, statistics.attempts + statistics.skippedOffline)
+        if statistics.attempts == 1 {
+            wait(1) { scheduler.statistics.successes == 1 }
+            verify(vendor).flushCache()
+        }
+    }
+
+    func testClientStartsTheSchedulerOnceDeferredDelegatesAreConstructed() throws {
+        let client = try makeClient(config: [.echoFlushSchedulerEnabled: "true", .echoDelegateConstructionDelay: "60"],
+                                    delegates: [MockEchoDelegateMock().withEnabledSuperclassSpy()])
+        XCTAssertNil(client.flushScheduler)
+
+        client.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        XCTAssertNotNil(client.flushScheduler)
+    }
+
+    func testClientHasNoSchedulerByDefault() throws {
+        let client = try makeClient(config: nil, delegates: [MockEchoDelegateMock().withEnabledSuperclassSpy()])
+
+        XCTAssertNil(client.flushScheduler)
+    }
+
+}
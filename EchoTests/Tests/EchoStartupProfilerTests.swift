@@ -0,0 +1,113 @@
+//
+//  EchoStartupProfilerTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoStartupProfilerTests: EchoClientTests {
+
+    override func tearDown() {
+        EchoClient.startupProfilingEnabled = false
+        super.tearDown()
+    }
+
+    func makeProfiledClient(delegateConstructionDelay: TimeInterval? = nil) -> EchoClient? {
+        EchoClient.startupProfilingEnabled = true
+        return try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                               config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                               brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock,
+                               delegateConstructionDelay: delegateConstructionDelay)
+    }
+
+    func testNoReportUnlessEnabled() {
+        XCTAssertNil(client.startupReport)
+    }
+
+    func testReportCoversEachPhaseInOrder() throws {
+        let report = try XCTUnwrap(makeProfiledClient()?.startupReport)
+
+        let names = report.phases.map { $0.name }
+        XCTAssertEqual(["config", "userPromiseHelper", "deviceID", "webviewStorage", "delegates"], Array(names.prefix(5)))
+        XCTAssertEqual("start", names.last)
+        XCTAssertEqual(echoMocks.count, names.filter { $0.hasPrefix("start.") }.count)
+    }
+
+    func testTotalCoversThePhases() throws {
+        let report = try XCTUnwrap(makeProfiledClient()?.startupReport)
+
+        let topLevel = report.phases.filter { !$0.name.hasPrefix("start.") }.reduce(0) { $0 + $1.duration }
+        XCTAssertGreaterThanOrEqual(report.total, topLevel)
+        XCTAssertEqual(report.total * 1000, report.millisecondsByPhase()["total"])
+    }
+
+    func testDeferredDelegatesAreNotTimedDuringInit() throws {
+        let profiled = makeProfiledClient(delegateConstructionDelay: 60)
+        let report = try XCTUnwrap(profiled?.startupReport)
+
+        XCTAssertNil(report.duration(of: "delegates"))
+
+        // Constructing them later does not change the report
+        profiled?.constructDelegates()
+        XCTAssertNil(profiled?.startupReport?.duration(of: "delegates"))
+    }
+
+    func testLaterStartsAreNotRecorded() throws {
+        config[.echoAutoStart] = "false"
+        let profiled = try XCTUnwrap(makeProfiledClient())
+
+        profiled.start()
+
+        XCTAssertNil(profiled.startupReport?.duration(of: "start"))
+        XCTAssertFalse(profiled.startupReport?.phases.contains { $0.name.hasPrefix("start.") } ?? true)
+    }
+
+    func testDisabledProfilerOnlyRunsTheWork() {
+        let profiler = EchoStartupProfiler(enabled: false)
+
+        XCTAssertEqual(2, profiler.measure("phase") { 1 + 1 })
+        XCTAssertNil(profiler.finish())
+    }
+
+    // MARK: - Startup cost, with mock delegates
+
+    func testPerformanceOfInit() {
+        measure {
+            XCTAssertNotNil(try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                                            config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                                            brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock))
+        }
+    }
+
+    func testPerformanceOfInitWhileProfiling() {
+        var reports = [EchoStartupReport]()
+
+        measure {
+            if let report = makeProfiledClient()?.startupReport {
+                reports.append(report)
+            }
+        }
+
+        // Average of each phase across the runs, for comparing against launch traces
+        var totals = [String: Double]()
+        for report in reports {
+            totals.merge(report.millisecondsByPhase(), uniquingKeysWith: +)
+        }
+        let averages = totals.sorted { $0.key < $1.key }
+                .map { String(format: "%@: %.3fms", $0.key, $0.value / Double(reports.count)) }
+        let attachment = XCTAttachment(string: averages.joined(separator: "\n"))
+        attachment.name = "Echo startup phases"
+        attachment.lifetime = .keepAlways
+        add(attachment)
+
+        XCTAssertFalse(reports.isEmpty)
+        for phase in ["config", "delegates"] {
+            XCTAssertNotNil(totals[phase], phase)
+        }
+    }
+
+}
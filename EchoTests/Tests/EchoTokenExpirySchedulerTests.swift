@@ -0,0 +1,147 @@
+//
+//  EchoTokenExpirySchedulerTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoTokenExpirySchedulerTests: XCTestCase {
+
+    let user = BBCUser(signedIn: true, hashedID: "1234", tokenRefreshTimestamp: Date())
+    let otherUser = BBCUser(signedIn: true, hashedID: "5678", tokenRefreshTimestamp: Date())
+
+    var clock: MockClock!
+    var expired: [BBCUser]!
+    var scheduler: EchoTokenExpiryScheduler!
+
+    override func setUp() {
+        super.setUp()
+        clock = MockClock()
+        clock.time = 1_000
+        expired = []
+        scheduler = EchoTokenExpiryScheduler(clock: clock) { [unowned self] user in
+            self.expired.append(user)
+        }
+    }
+
+    /// Lets callbacks queued on the main queue run
+    func drainMainQueue() {
+        let drained = expectation(description: "drained")
+        DispatchQueue.main.async { drained.fulfill() }
+        wait(for: [drained], timeout: 2)
+    }
+
+    func testExpiresOnceTheClockPassesTheDeadline() {
+        scheduler.schedule(user, timeUntilExpiry: 60)
+
+        clock.time += 59
+        scheduler.expireIfDue()
+        drainMainQueue()
+        XCTAssertTrue(expired.isEmpty)
+
+        clock.time += 1
+        scheduler.expireIfDue()
+        drainMainQueue()
+        XCTAssertEqual(1, expired.count)
+        XCTAssertTrue(expired.first === user)
+        XCTAssertNil(scheduler.deadline)
+    }
+
+    func testExpiresOnlyOnce() {
+        scheduler.schedule(user, timeUntilExpiry: 60)
+        clock.time += 120
+
+        scheduler.expireIfDue()
+        scheduler.expireIfDue()
+        drainMainQueue()
+
+        XCTAssertEqual(1, expired.count)
+    }
+
+    func testSchedulingFromABackgroundQueueWithoutARunLoop() {
+        let scheduled = expectation(description: "scheduled")
+        DispatchQueue.global().async {
+            self.scheduler.schedule(self.user, timeUntilExpiry: 60)
+            scheduled.fulfill()
+        }
+        wait(for: [scheduled], timeout: 2)
+
+        XCTAssertEqual(1_060, scheduler.deadline)
+    }
+
+    func testTimerFiresWithTheRealClock() {
+        let realClockScheduler = EchoTokenExpiryScheduler { [unowned self] user in
+            self.expired.append(user)
+        }
+        let fired = expectation(description: "fired")
+
+        DispatchQueue.global().async {
+            realClockScheduler.schedule(self.user, timeUntilExpiry: 0.05)
+        }
+        DispatchQueue.main.asyncAfter(deadline: .now() + 1.5) {
+            fired.fulfill()
+        }
+        wait(for: [fired], timeout: 3)
+
+        XCTAssertEqual(1, expired.count)
+    }
+
+    func testRepeatedSchedulesOfTheSameTokenAreCoalesced() {
+        for _ in 0..<10 {
+            scheduler.schedule(user, timeUntilExpiry: 60)
+        }
+        scheduler.schedule(otherUser, timeUntilExpiry: 60)
+
+        XCTAssertEqual(1, scheduler.counts.rescheduled)
+        XCTAssertEqual(10, scheduler.counts.coalesced)
+
+        clock.time += 60
+        scheduler.expireIfDue()
+        drainMainQueue()
+        // One fan-out, for the latest user
+        XCTAssertEqual(1, expired.count)
+        XCTAssertTrue(expired.first === otherUser)
+    }
+
+    func testANewTokenReplacesTheSchedule() {
+        scheduler.schedule(user, timeUntilExpiry: 60)
+        clock.time += 30
+        scheduler.schedule(user, timeUntilExpiry: 60)
+
+        XCTAssertEqual(1_090, scheduler.deadline)
+        clock.time += 30
+        scheduler.expireIfDue()
+        drainMainQueue()
+        XCTAssertTrue(expired.isEmpty)
+    }
+
+    func testCancelledAndAlreadyExpiredTokensDoNotFire() {
+        scheduler.schedule(user, timeUntilExpiry: 60)
+        scheduler.cancel()
+        scheduler.schedule(otherUser, timeUntilExpiry: 0)
+
+        clock.time += 120
+        scheduler.expireIfDue()
+        drainMainQueue()
+
+        XCTAssertTrue(expired.isEmpty)
+        XCTAssertNil(scheduler.deadline)
+    }
+
+    func testExpiryDueBeforeANewScheduleIsDropped() {
+        scheduler.schedule(user, timeUntilExpiry: 60)
+        clock.time += 60
+        scheduler.expireIfDue()
+        // Rescheduled before the main queue delivered the expiry
+        scheduler.schedule(otherUser, timeUntilExpiry: 600)
+
+        drainMainQueue()
+
+        XCTAssertTrue(expired.isEmpty)
+    }
+
+}
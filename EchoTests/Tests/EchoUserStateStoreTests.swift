@@ -0,0 +1,229 @@
+//
+//  EchoUserStateStoreTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoUserStateStoreTests: XCTestCase {
+
+    class FailingBackend: EchoUserStateBackend {
+        var failing = true
+        var saved: Data?
+
+        func load() -> Data? {
+            return saved
+        }
+
+        func save(_ data: Data) throws {
+            if failing {
+                throw CocoaError(.fileWriteNoPermission)
+            }
+            saved = data
+        }
+
+        func remove() throws {
+            saved = nil
+        }
+    }
+
+    var directory: URL!
+    var backend: EchoFileUserStateBackend!
+    var defaults: UserDefaults!
+
+    override func setUp() {
+        super.setUp()
+        directory = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString)
+        backend = EchoFileUserStateBackend(url: directory.appendingPathComponent("state.json"))
+        UserDefaults().removePersistentDomain(forName: "userStateDefaults")
+        defaults = UserDefaults(suiteName: "userStateDefaults")
+    }
+
+    override func tearDown() {
+        defaults.removePersistentDomain(forName: "userStateDefaults")
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func makeStore(interval: TimeInterval = 60) -> EchoUserStateStore {
+        return EchoUserStateStore(backend: backend, legacyDefaults: defaults, coalescingInterval: interval)
+    }
+
+    func testUpdatesAreReadFromMemoryBeforeTheyAreWritten() {
+        let store = makeStore()
+
+        store.update { $0.deviceID = "device-1" }
+
+        XCTAssertEqual("device-1", store.state.deviceID)
+        XCTAssertTrue(store.hasUnsavedChanges)
+        XCTAssertNil(backend.load())
+    }
+
+    func testUpdatesAreCoalescedIntoOneWrite() {
+        let store = makeStore(interval: 0.1)
+
+        store.update { $0.deviceID = "device-1" }
+        store.update { $0.signedIn = true }
+        store.update { $0.hashedID = "1234" }
+
+        let written = expectation(description: "written")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.5) { written.fulfill() }
+        wait(for: [written], timeout: 2)
+
+        XCTAssertEqual(1, store.writeCount)
+        XCTAssertFalse(store.hasUnsavedChanges)
+        XCTAssertEqual("1234", makeStore().state.hashedID)
+    }
+
+    func testUnchangedUpdatesAreNotWritten() {
+        let store = makeStore()
+
+        store.update { $0.signedIn = false }
+        store.flush()
+
+        XCTAssertEqual(0, store.writeCount)
+    }
+
+    func testFlushWritesStraightAway() {
+        let store = makeStore()
+        store.update { $0.postponedUserStateTransition = "sign_in" }
+
+        store.flush()
+
+        XCTAssertEqual(1, store.writeCount)
+        let reopened = makeStore()
+        XCTAssertEqual(.record, reopened.source)
+        XCTAssertEqual("sign_in", reopened.state.postponedUserStateTransition)
+    }
+
+    // MARK: - Crash consistency
+
+    func testCrashBeforeWritingKeepsThePreviousRecord() {
+        var store: EchoUserStateStore? = makeStore()
+        store?.update { $0.deviceID = "first" }
+        store?.flush()
+
+        store?.update { $0.deviceID = "second" }
+        // The process dies before the coalesced write runs
+        store = nil
+
+        XCTAssertEqual("first", makeStore().state.deviceID)
+    }
+
+    func testInterruptedReplacementLeavesTheRecordReadable() throws {
+        let store = makeStore()
+        store.update { $0.deviceID = "first" }
+        store.flush()
+
+        // A crash part way through an atomic write leaves a partial temporary file beside the record
+        let partial = try JSONEncoder().encode(EchoUserState(deviceID: "second")).prefix(10)
+        try partial.write(to: directory.appendingPathComponent(".state.json.tmp"))
+
+        XCTAssertEqual("first", makeStore().state.deviceID)
+    }
+
+    func testUnreadableRecordIsTreatedAsMissing() throws {
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true, attributes: nil)
+        try Data("{\"version\": 1, \"signedIn\":".utf8).write(to: backend.url)
+
+        let store = makeStore()
+
+        XCTAssertEqual(.empty, store.source)
+        XCTAssertEqual(EchoUserState(), store.state)
+    }
+
+    func testFailedWritesAreRetried() {
+        let failing = FailingBackend()
+        let store = EchoUserStateStore(backend: failing, legacyDefaults: nil, coalescingInterval: 60)
+        store.update { $0.deviceID = "device-1" }
+
+        store.flush()
+        XCTAssertTrue(store.hasUnsavedChanges)
+
+        failing.failing = false
+        store.flush()
+        XCTAssertFalse(store.hasUnsavedChanges)
+        XCTAssertNotNil(failing.saved)
+    }
+
+    // MARK: - Migration on echoUpgrade
+
+    func testStateIsMigratedFromLegacyKeys() {
+        defaults.set("legacy-device", forKey: UserDefaultsKeys.echoDeviceID.rawValue)
+        defaults.set("1234", forKey: UserDefaultsKeys.echoHashedID.rawValue)
+        defaults.set(true, forKey: UserDefaultsKeys.echoSignedIn.rawValue)
+        defaults.set("hardware", forKey: UserDefaultsKeys.echoHardwareID.rawValue)
+        defaults.set(1_500_000_000.0, forKey: UserDefaultsKeys.echoDeviceIDCreationDate.rawValue)
+
+        let store = makeStore()
+
+        XCTAssertEqual(.legacyDefaults, store.source)
+        XCTAssertEqual("legacy-device", store.state.deviceID)
+        XCTAssertEqual("1234", store.state.hashedID)
+        XCTAssertTrue(store.state.signedIn)
+        XCTAssertEqual("hardware", store.state.hardwareID)
+        XCTAssertEqual(Date(timeIntervalSince1970: 1_500_000_000), store.state.deviceIDCreationDate)
+    }
+
+    func testMigrationHappensOnce() {
+        defaults.set("legacy-device", forKey: UserDefaultsKeys.echoDeviceID.rawValue)
+        let store = makeStore()
+        store.flush()
+
+        store.update { $0.deviceID = "new-device" }
+        store.flush()
+
+        let reopened = makeStore()
+        XCTAssertEqual(.record, reopened.source)
+        XCTAssertEqual("new-device", reopened.state.deviceID)
+    }
+
+    func testNothingIsMigratedForAFreshInstall() {
+        let store = makeStore()
+
+        XCTAssertEqual(.empty, store.source)
+        store.flush()
+        XCTAssertEqual(0, store.writeCount)
+    }
+
+    func testClearRemovesTheRecordButNotTheLegacyKeys() {
+        defaults.set("legacy-device", forKey: UserDefaultsKeys.echoDeviceID.rawValue)
+        let store = makeStore()
+        store.flush()
+        store.update { $0.hashedID = "1234" }
+
+        store.clear()
+        store.flush()
+
+        XCTAssertEqual(EchoUserState(), store.state)
+        XCTAssertNil(backend.load())
+        // The UserPromiseHelper's keys stay authoritative, so the next launch migrates from them again
+        XCTAssertEqual("legacy-device", defaults.string(forKey: UserDefaultsKeys.echoDeviceID.rawValue))
+        XCTAssertEqual(.legacyDefaults, makeStore().source)
+    }
+
+    // MARK: - Performance
+
+    func testPerformanceOfUpdates() {
+        let store = makeStore()
+
+        measure {
+            for index in 0..<10_000 {
+                store.update { $0.hashedID = String(index) }
+            }
+        }
+    }
+
+    func testPerformanceOfUserDefaultsWrites() {
+        measure {
+            for index in 0..<10_000 {
+                defaults.set(String(index), forKey: UserDefaultsKeys.echoHashedID.rawValue)
+            }
+        }
+    }
+
+}
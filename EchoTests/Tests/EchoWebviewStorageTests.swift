@@ -0,0 +1,174 @@
+//
+//  EchoWebviewStorageTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class EchoWebviewStorageTests: EchoClientTests {
+
+    /// Stands in for a cookie store which is slow on a cold start
+    class SlowWebviewStorage: EchoWebviewStorage {
+        let delay: TimeInterval
+        private(set) var clearCount = 0
+
+        init(delay: TimeInterval) {
+            self.delay = delay
+        }
+
+        func clearWebviewCookies() {
+            Thread.sleep(forTimeInterval: delay)
+            clearCount += 1
+        }
+    }
+
+    func makeClient(storage: EchoWebviewStorage) -> EchoClient? {
+        return try? EchoClient(appName: cleanAppName, appType: .mobileApp, startCounterName: startCounterName,
+                               config: config, echoDelegateFactory: factoryMock, device: deviceMock,
+                               brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock, webviewStorage: storage)
+    }
+
+    func waitUntilFinished(_ task: EchoWebviewStorageTask) -> EchoWebviewStorageTask.Outcome? {
+        var result: EchoWebviewStorageTask.Outcome?
+        let finished = expectation(description: "finished")
+        task.whenFinished { outcome in
+            result = outcome
+            finished.fulfill()
+        }
+        wait(for: [finished], timeout: 5)
+        return result
+    }
+
+    func testInitDoesNotWaitForCookieClearing() throws {
+        let storage = SlowWebviewStorage(delay: 0.5)
+        let started = Date()
+
+        let slowClient = try XCTUnwrap(makeClient(storage: storage))
+
+        XCTAssertLessThan(Date().timeIntervalSince(started), 0.5)
+        let task = try XCTUnwrap(slowClient.webviewStorageTask)
+        XCTAssertFalse(task.isFinished)
+
+        guard case .some(.finished(let duration)) = waitUntilFinished(task) else {
+            return XCTFail("Cookie clearing did not run")
+        }
+        XCTAssertGreaterThanOrEqual(duration, 0.5)
+        XCTAssertEqual(1, storage.clearCount)
+    }
+
+    func testNoCookieClearingWithIDv5() {
+        config[.idv5Enabled] = "true"
+        let storage = SlowWebviewStorage(delay: 0)
+
+        XCTAssertNil(makeClient(storage: storage)?.webviewStorageTask)
+    }
+
+    func testCancelledBeforeStartingDoesNotRun() {
+        let queue = DispatchQueue(label: "EchoWebviewStorageTests")
+        queue.suspend()
+        let storage = SlowWebviewStorage(delay: 0)
+        let task = EchoWebviewStorageTask(queue: queue) {
+            storage.clearWebviewCookies()
+        }
+
+        XCTAssertTrue(task.cancel())
+        queue.resume()
+
+        guard case .some(.cancelled) = waitUntilFinished(task) else {
+            return XCTFail("Task was not cancelled")
+        }
+        queue.sync {}
+        XCTAssertEqual(0, storage.clearCount)
+    }
+
+    func testStartedWorkCannotBeCancelled() {
+        let queue = DispatchQueue(label: "EchoWebviewStorageTests")
+        let started = DispatchSemaphore(value: 0)
+        let storage = SlowWebviewStorage(delay: 0.2)
+        let task = EchoWebviewStorageTask(queue: queue) {
+            started.signal()
+            storage.clearWebviewCookies()
+        }
+        started.wait()
+
+        XCTAssertFalse(task.cancel())
+        guard case .some(.finished) = waitUntilFinished(task) else {
+            return XCTFail("Started work did not finish")
+        }
+        XCTAssertEqual(1, storage.clearCount)
+    }
+
+    func testWorkRunsOnTheMainQueueAfterInitReturns() {
+        var ranOnMain: Bool?
+        let task = EchoWebviewStorageTask {
+            ranOnMain = Thread.isMainThread
+        }
+        XCTAssertNil(ranOnMain)
+
+        _ = waitUntilFinished(task)
+        XCTAssertEqual(true, ranOnMain)
+    }
+
+    func testPendingWorkRunsBeforeLaterCookieWrites() {
+        var calls = [String]()
+        let task = EchoWebviewStorageTask {
+            calls.append("clear")
+        }
+
+        task.runPendingWork()
+        calls.append("write")
+
+        XCTAssertEqual(["clear", "write"], calls)
+        XCTAssertTrue(task.isFinished)
+        _ = waitUntilFinished(task)
+        XCTAssertEqual(["clear", "write"], calls, "The queued run should not clear again")
+    }
+
+    func testRunPendingWorkWaitsForWorkStartedElsewhere() {
+        let queue = DispatchQueue(label: "EchoWebviewStorageTests")
+        let started = DispatchSemaphore(value: 0)
+        let storage = SlowWebviewStorage(delay: 0.2)
+        let task = EchoWebviewStorageTask(queue: queue) {
+            started.signal()
+            storage.clearWebviewCookies()
+        }
+        started.wait()
+
+        task.runPendingWork()
+
+        XCTAssertTrue(task.isFinished)
+        XCTAssertEqual(1, storage.clearCount)
+    }
+
+    func testRunPendingWorkAfterCancellingDoesNotRun() {
+        let storage = SlowWebviewStorage(delay: 0)
+        let task = EchoWebviewStorageTask.clearingCookies(in: storage)
+        task.cancel()
+
+        task.runPendingWork()
+
+        XCTAssertEqual(0, storage.clearCount)
+    }
+
+    func testCallbacksAddedAfterFinishingAreStillCalled() {
+        let task = EchoWebviewStorageTask.clearingCookies(in: SlowWebviewStorage(delay: 0))
+        _ = waitUntilFinished(task)
+
+        XCTAssertNotNil(waitUntilFinished(task))
+    }
+
+    // MARK: - Performance
+
+    func testPerformanceOfInitWithSlowCookieStore() {
+        let storage = SlowWebviewStorage(delay: 0.2)
+
+        measure {
+            XCTAssertNotNil(makeClient(storage: storage))
+        }
+    }
+
+}
@@ -0,0 +1,358 @@
+//
+//  IsolatedDelegateTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import Cuckoo
+import XCTest
+@testable import Echo
+
+class IsolatedDelegateTests: EchoClientTests {
+
+    /**
+     Stands in for an SDK which takes `duration` by `clock` on every view, and which blocks, e.g. on a
+     disk write, while `blocking` until the test releases it.
+     */
+    class SlowDelegate: EchoDelegateMock, EchoIsolatableDelegate {
+        let clock: MockClock
+        let duration: TimeInterval
+        var blocking = false
+        /// Signalled as each blocking call starts
+        let entered = DispatchSemaphore(value: 0)
+        private let gate = DispatchSemaphore(value: 0)
+        private let lock = NSLock()
+        private var viewed = [String]()
+
+        init(clock: MockClock, duration: TimeInterval = 0) {
+            self.clock = clock
+            self.duration = duration
+        }
+
+        var counterNames: [String] {
+            lock.lock()
+            defer { lock.unlock() }
+            return viewed
+        }
+
+        func release(calls: Int = 1) {
+            (0..<calls).forEach { _ in gate.signal() }
+        }
+
+        private func block() {
+            if blocking {
+                entered.signal()
+                gate.wait()
+            }
+        }
+
+        override func viewEvent(counterName: String, eventLabels: [String: String]?) {
+            block()
+            clock.time += duration
+            lock.lock()
+            viewed.append(counterName)
+            lock.unlock()
+        }
+
+        override func getDeviceID() -> String? {
+            block()
+            return "slowDevice"
+        }
+
+        override func getCacheMode() -> EchoCacheMode {
+            return .all
+        }
+    }
+
+    var clock: MockClock!
+
+    override func setUp() {
+        super.setUp()
+        clock = MockClock()
+    }
+
+    func isolate(_ delegate: EchoIsolatableDelegate, shedAfter: Int? = nil, resultTimeout: TimeInterval = 60) -> IsolatedDelegate {
+        var configuration = IsolatedDelegate.Configuration()
+        configuration.budget = 0.05
+        configuration.shedAfter = shedAfter
+        configuration.resultTimeout = resultTimeout
+        let isolated = IsolatedDelegate(delegate, configuration: configuration, clock: clock)
+        isolated.drain()
+        return isolated
+    }
+
+    /// Records reports, which arrive on the diagnostics queue, for reading after `drain`
+    func recordReports(_ isolated: IsolatedDelegate) -> () -> [IsolatedDelegate.SlowCall] {
+        let lock = NSLock()
+        var reports = [IsolatedDelegate.SlowCall]()
+        isolated.onSlowCall = { slow in
+            lock.lock()
+            reports.append(slow)
+            lock.unlock()
+        }
+        return {
+            lock.lock()
+            defer { lock.unlock() }
+            return reports
+        }
+    }
+
+    /// Runs `work` off the main thread and waits for it
+    func inBackground<T>(_ work: @escaping () -> T) -> T? {
+        var value: T?
+        let done = expectation(description: "background call returned")
+        DispatchQueue.global().async {
+            value = work()
+            done.fulfill()
+        }
+        wait(for: [done], timeout: 10)
+        return value
+    }
+
+    func testBlockedDelegateDoesNotHoldUpTheCallerOrOtherDelegates() {
+        let blocked = SlowDelegate(clock: clock)
+        let fast = SlowDelegate(clock: clock)
+        let isolated = [isolate(blocked), isolate(fast)]
+        blocked.blocking = true
+
+        isolated.forEach { $0.viewEvent(counterName: "news.page", eventLabels: nil) }
+        blocked.entered.wait()
+
+        isolated[1].drain()
+        XCTAssertEqual(["news.page"], fast.counterNames)
+        XCTAssertTrue(blocked.counterNames.isEmpty)
+
+        blocked.release()
+        isolated[0].drain()
+        XCTAssertEqual(["news.page"], blocked.counterNames)
+    }
+
+    func testCallsReachTheDelegateInOrder() {
+        let delegate = SlowDelegate(clock: clock)
+        let isolated = isolate(delegate)
+        let names = (0..<100).map { "page.\($0)" }
+
+        names.forEach { isolated.viewEvent(counterName: $0, eventLabels: nil) }
+        isolated.drain()
+
+        XCTAssertEqual(names, delegate.counterNames)
+    }
+
+    func testSlowCallsAreReported() {
+        let isolated = isolate(SlowDelegate(clock: clock, duration: 0.1))
+        let reports = recordReports(isolated)
+
+        isolated.viewEvent(counterName: "news.page", eventLabels: nil)
+        isolated.drain()
+
+        XCTAssertEqual(1, reports().count)
+        let slow = reports().first
+        XCTAssertEqual("SlowDelegate", slow?.delegate)
+        XCTAssertEqual(true, slow?.call.hasPrefix("viewEvent"))
+        XCTAssertEqual(0.1, slow?.duration)
+        XCTAssertEqual(true, slow?.returned)
+        XCTAssertEqual(false, slow?.shed)
+        XCTAssertEqual(1, isolated.statistics.slowCalls)
+    }
+
+    func testStalledCallIsReportedWhileTheDelegateIsStillBlocked() {
+        let delegate = SlowDelegate(clock: clock)
+        let isolated = isolate(delegate)
+        let reported = expectation(description: "stalled call reported")
+        isolated.onSlowCall = { slow in
+            XCTAssertFalse(slow.returned)
+            XCTAssertEqual(0.2, slow.duration)
+            reported.fulfill()
+        }
+        delegate.blocking = true
+
+        isolated.viewEvent(counterName: "news.page", eventLabels: nil)
+        delegate.entered.wait()
+        clock.time += 0.2
+        isolated.checkStalled()
+
+        // Reported although the delegate's own queue is still blocked
+        wait(for: [reported], timeout: 10)
+        delegate.release()
+        isolated.drain()
+    }
+
+    func testWatchdogReportsAStalledCallWithoutAnotherCall() {
+        let delegate = SlowDelegate(clock: clock)
+        let isolated = isolate(delegate)
+        let reported = expectation(description: "stalled call reported by the watchdog")
+        isolated.onSlowCall = { _ in reported.fulfill() }
+        delegate.blocking = true
+
+        isolated.viewEvent(counterName: "news.page", eventLabels: nil)
+        delegate.entered.wait()
+        clock.time += 0.2
+
+        // The watchdog fires one budget after the call started
+        wait(for: [reported], timeout: 10)
+        delegate.release()
+        isolated.drain()
+    }
+
+    func testCallStillRunningIsReportedOnce() {
+        let delegate = SlowDelegate(clock: clock)
+        let isolated = isolate(delegate)
+        let reports = recordReports(isolated)
+        delegate.blocking = true
+
+        isolated.viewEvent(counterName: "first", eventLabels: nil)
+        delegate.entered.wait()
+        clock.time += 0.2
+        isolated.viewEvent(counterName: "second", eventLabels: nil)
+        isolated.checkStalled()
+        delegate.release(calls: 2)
+        isolated.drain()
+
+        XCTAssertEqual([false], reports().map { $0.returned })
+        XCTAssertEqual(1, isolated.statistics.slowCalls)
+    }
+
+    func testDelegateWhichKeepsStallingIsShed() {
+        let delegate = SlowDelegate(clock: clock, duration: 0.1)
+        let isolated = isolate(delegate, shedAfter: 2)
+
+        isolated.viewEvent(counterName: "first", eventLabels: nil)
+        isolated.drain()
+        XCTAssertFalse(isolated.isShed)
+        isolated.viewEvent(counterName: "second", eventLabels: nil)
+        isolated.drain()
+        XCTAssertTrue(isolated.isShed)
+
+        isolated.viewEvent(counterName: "third", eventLabels: nil)
+        isolated.drain()
+
+        XCTAssertEqual(["first", "second"], delegate.counterNames)
+        XCTAssertEqual(1, isolated.statistics.dropped)
+    }
+
+    func testFastCallResetsTheRunTowardsShedding() {
+        let isolated = isolate(SlowDelegate(clock: clock, duration: 0.1), shedAfter: 2)
+
+        isolated.viewEvent(counterName: "slow", eventLabels: nil)
+        isolated.setCounterName("fast")
+        isolated.viewEvent(counterName: "slow", eventLabels: nil)
+        isolated.drain()
+
+        XCTAssertFalse(isolated.isShed)
+    }
+
+    // MARK: - Results
+
+    func testResultsFromAResponsiveDelegate() {
+        let isolated = isolate(SlowDelegate(clock: clock))
+
+        XCTAssertEqual("slowDevice", inBackground { isolated.getDeviceID() } ?? nil)
+        XCTAssertEqual(.all, inBackground { isolated.getCacheMode() })
+    }
+
+    func testMainThreadGetsTheLatestResultWithoutWaiting() {
+        let delegate = SlowDelegate(clock: clock)
+        let isolated = isolate(delegate)
+        delegate.blocking = true
+
+        // With a minute's timeout, waiting here would hang the test
+        XCTAssertEqual("slowDevice", isolated.getDeviceID())
+        XCTAssertEqual(.all, isolated.getCacheMode())
+
+        delegate.release()
+        isolated.drain()
+    }
+
+    func testFirstResultsOnTheMainThreadWaitForTheDelegate() {
+        let delegate = SlowDelegate(clock: clock)
+        delegate.blocking = true
+        let isolated = IsolatedDelegate(delegate, clock: clock)
+        DispatchQueue.global().async {
+            delegate.entered.wait()
+            // The call asked for in init, then the one asked for below
+            delegate.release(calls: 2)
+        }
+
+        // Straight after construction, before the results asked for in init are in
+        XCTAssertEqual("slowDevice", isolated.getDeviceID())
+        XCTAssertEqual(.all, isolated.getCacheMode())
+
+        isolated.drain()
+    }
+
+    func testFirstResultsOnTheMainThreadGiveUpOnABlockedDelegate() {
+        let delegate = SlowDelegate(clock: clock)
+        delegate.blocking = true
+        var configuration = IsolatedDelegate.Configuration()
+        configuration.resultTimeout = 0.05
+        let isolated = IsolatedDelegate(delegate, configuration: configuration, clock: clock)
+
+        XCTAssertNil(isolated.getDeviceID())
+        XCTAssertEqual(.offline, isolated.getCacheMode())
+
+        delegate.release(calls: 2)
+        isolated.drain()
+    }
+
+    func testResultsGiveUpOnABlockedDelegate() {
+        let delegate = SlowDelegate(clock: clock)
+        let isolated = isolate(delegate, resultTimeout: 0.05)
+        delegate.blocking = true
+
+        XCTAssertEqual("slowDevice", inBackground { isolated.getDeviceID() } ?? nil, "The latest result is returned")
+
+        delegate.release()
+        isolated.drain()
+    }
+
+    func testResultsFromAShedDelegateDoNotWait() {
+        let isolated = isolate(SlowDelegate(clock: clock, duration: 0.1), shedAfter: 1)
+        isolated.viewEvent(counterName: "slow", eventLabels: nil)
+        isolated.drain()
+        XCTAssertTrue(isolated.isShed)
+
+        // Nothing is queued to signal the result, so waiting here would take the minute's timeout
+        XCTAssertEqual("slowDevice", inBackground { isolated.getDeviceID() } ?? nil)
+    }
+
+    // MARK: - Client
+
+    func testClientIsolatesOnlyIsolatableDelegates() throws {
+        config[.echoCollectorURL] = CollectorStandInServer.url.absoluteString
+        let isolatedClient = try XCTUnwrap(try? EchoClient(appName: cleanAppName, appType: .mobileApp,
+                                                           startCounterName: startCounterName, config: config,
+                                                           echoDelegateFactory: factoryMock, device: deviceMock,
+                                                           brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock,
+                                                           delegateIsolation: IsolatedDelegate.Configuration()))
+        let isolated = isolatedClient.delegates.compactMap { $0 as? IsolatedDelegate }
+        XCTAssertEqual(1, isolated.count)
+        XCTAssertTrue(isolated.first?.wrapped is EchoCollectorDelegate)
+
+        // The vendor SDK delegates stay on the main thread, so are called before viewEvent returns
+        isolatedClient.viewEvent(counterName: "news.page", eventLabels: nil)
+
+        verify(mock1).viewEvent(counterName: "news.page", eventLabels: any())
+        verify(mock2).viewEvent(counterName: "news.page", eventLabels: any())
+        isolated.forEach { $0.drain() }
+    }
+
+    func testIsolationCanBeEnabledInConfig() throws {
+        config[.echoDelegateIsolationEnabled] = "true"
+        config[.echoCollectorURL] = CollectorStandInServer.url.absoluteString
+        let isolatedClient = try XCTUnwrap(try? EchoClient(appName: cleanAppName, appType: .mobileApp,
+                                                           startCounterName: startCounterName, config: config,
+                                                           echoDelegateFactory: factoryMock, device: deviceMock,
+                                                           brokerFactory: brokerFactoryMock, bbcUser: bbcUserMock))
+
+        let isolated = isolatedClient.delegates.compactMap { $0 as? IsolatedDelegate }
+        XCTAssertEqual(1, isolated.count)
+        XCTAssertTrue(isolated.first?.wrapped is EchoCollectorDelegate)
+    }
+
+    func testDelegatesAreNotIsolatedByDefault() throws {
+        XCTAssertFalse(client.delegates.contains { $0 is IsolatedDelegate })
+    }
+
+}
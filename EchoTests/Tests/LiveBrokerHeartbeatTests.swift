@@ -34,7 +34,8 @@ class LiveBrokerHeartbeatTests: EchoClientTests {
         liveProtocol = MockLiveProtocolMock().withEnabledSuperclassSpy()
 
         let broadcast = Broadcast(startTime: 12345, endTime: 1122345, episodeId: "epId",
-                              episodeTitle: "Sherlock", id: "1", versionId: "b038nzy4", brandTitle: "title")
+                              episodeTitle: "Sherlock", id: "1", versionId: "b038nzy4", brandTitle: "title",
+                              pool: BroadcastStringPool())
 
         schedule = ScheduleMock()
         schedule.dataAvailable = true
@@ -27,7 +27,8 @@ class LiveBrokerTests: XCTestCase {
         liveProtocolMock = LiveProtocolMock()
 
         broadcast = Broadcast(startTime: 12345, endTime: 1122345, episodeId: "epId",
-                episodeTitle: "Sherlock", id: "1", versionId: "b038nzy4", brandTitle: "title")
+                episodeTitle: "Sherlock", id: "1", versionId: "b038nzy4", brandTitle: "title",
+                pool: BroadcastStringPool())
 
         playerDelegateMock.timestamp = 12345
         scheduleMock.dataAvailable = true
@@ -73,7 +74,8 @@ class LiveBrokerTests: XCTestCase {
         playheadMock.position = 5000
 
         let b = Broadcast(startTime: 1454565600000, endTime: 1454577300000, episodeId: "epId",
-                episodeTitle: "BBC News", id: "1", versionId: "new_id", brandTitle: "title")
+                episodeTitle: "BBC News", id: "1", versionId: "new_id", brandTitle: "title",
+                pool: BroadcastStringPool())
 
         scheduleMock.dataAvailable = true
         scheduleMock.broadcast = b
@@ -0,0 +1,82 @@
+//
+//  LiveClockOffsetEstimatorTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class LiveClockOffsetEstimatorTests: XCTestCase {
+
+    var estimator: LiveClockOffsetEstimator!
+
+    override func setUp() {
+        super.setUp()
+        estimator = LiveClockOffsetEstimator(driftTolerance: 2)
+    }
+
+    func testNoTimestampBeforeFirstSample() {
+        XCTAssertNil(estimator.timestamp(at: 1000))
+    }
+
+    func testTimestampIsDerivedFromPosition() {
+        XCTAssertTrue(estimator.sample(timestamp: 1000, position: 10000))
+
+        XCTAssertEqual(1000, estimator.timestamp(at: 10000)!, accuracy: 0.0001)
+        XCTAssertEqual(1005, estimator.timestamp(at: 15000)!, accuracy: 0.0001)
+    }
+
+    func testSamplesWithinToleranceDoNotResample() {
+        estimator.sample(timestamp: 1000, position: 10000)
+
+        XCTAssertFalse(estimator.sample(timestamp: 1001.5, position: 11000))
+        XCTAssertFalse(estimator.sample(timestamp: 1060, position: 70000))
+
+        XCTAssertEqual(1, estimator.sampleCount)
+        XCTAssertEqual(1000, estimator.timestamp(at: 10000)!, accuracy: 0.0001)
+    }
+
+    func testDriftBeyondToleranceResamples() {
+        estimator.sample(timestamp: 1000, position: 10000)
+
+        XCTAssertTrue(estimator.sample(timestamp: 1030, position: 20000))
+
+        XCTAssertEqual(2, estimator.sampleCount)
+        XCTAssertEqual(1030, estimator.timestamp(at: 20000)!, accuracy: 0.0001)
+    }
+
+    func testInvalidateDiscardsOffset() {
+        estimator.sample(timestamp: 1000, position: 10000)
+
+        estimator.invalidate()
+
+        XCTAssertNil(estimator.timestamp(at: 10000))
+        XCTAssertTrue(estimator.sample(timestamp: 1000, position: 10000))
+    }
+
+    func testSampleIsDueOncePerLabelInterval() {
+        let estimator = LiveClockOffsetEstimator(driftTolerance: 2, labelInterval: 10)
+        XCTAssertTrue(estimator.sampleDue(at: 1000))
+        estimator.sample(timestamp: 1000, position: 10000)
+
+        XCTAssertFalse(estimator.sampleDue(at: 1009))
+        XCTAssertTrue(estimator.sampleDue(at: 1010))
+        XCTAssertTrue(estimator.sampleDue(at: 990))
+
+        estimator.invalidate()
+        XCTAssertTrue(estimator.sampleDue(at: 1001))
+    }
+
+    func testPerformanceOfSamplingEveryTick() {
+        measure {
+            let estimator = LiveClockOffsetEstimator()
+            for tick in 0..<100_000 {
+                estimator.sample(timestamp: 1455290000 + TimeInterval(tick), position: UInt64(tick) * 1000)
+            }
+        }
+    }
+
+}
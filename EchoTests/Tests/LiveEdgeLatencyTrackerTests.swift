@@ -0,0 +1,84 @@
+//
+//  LiveEdgeLatencyTrackerTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class LiveEdgeLatencyTrackerTests: XCTestCase {
+
+    var tracker: LiveEdgeLatencyTracker!
+
+    override func setUp() {
+        super.setUp()
+        tracker = LiveEdgeLatencyTracker()
+    }
+
+    func testNoLabelsBeforeFirstSample() {
+        XCTAssertNil(tracker.current)
+        XCTAssertNil(tracker.percentile(0.5))
+        XCTAssertTrue(tracker.labels().isEmpty)
+    }
+
+    func testLatencyIsTakenFromEchoTimestamp() {
+        tracker.record(EchoTimestamp(currentTimestamp: 1455290000, liveEdgeTimestamp: 1455290012.5))
+
+        XCTAssertEqual(12.5, tracker.current!, accuracy: 0.0001)
+    }
+
+    func testPlaybackAheadOfReportedEdgeCountsAsZero() {
+        tracker.record(EchoTimestamp(currentTimestamp: 1455290001, liveEdgeTimestamp: 1455290000))
+
+        XCTAssertEqual(0, tracker.current!)
+    }
+
+    func testPercentilesAreWithinOneBucket() {
+        for second in 1...100 {
+            tracker.record(latency: TimeInterval(second) / 10)
+        }
+
+        XCTAssertEqual(5, tracker.percentile(0.5)!, accuracy: 0.25)
+        XCTAssertEqual(9.5, tracker.percentile(0.95)!, accuracy: 0.25)
+    }
+
+    func testLongLatenciesUseCoarseBuckets() {
+        tracker.record(latency: 3600)
+
+        XCTAssertEqual(3600, tracker.percentile(0.5)!, accuracy: 15)
+    }
+
+    func testLabelsAreInMilliseconds() {
+        tracker.record(latency: 10)
+        tracker.record(latency: 20)
+
+        let labels = tracker.labels()
+
+        XCTAssertEqual("20000", labels[EchoLiveLabelKeys.LiveEdgeLatency.rawValue])
+        XCTAssertEqual("10000", labels[EchoLiveLabelKeys.LiveEdgeLatencyP50.rawValue])
+        XCTAssertNotNil(labels[EchoLiveLabelKeys.LiveEdgeLatencyP95.rawValue])
+    }
+
+    func testResetClearsSession() {
+        tracker.record(latency: 10)
+
+        tracker.reset()
+
+        XCTAssertEqual(0, tracker.sampleCount)
+        XCTAssertTrue(tracker.labels().isEmpty)
+    }
+
+    func testPerformanceOfRecordingASession() {
+        measure {
+            let tracker = LiveEdgeLatencyTracker()
+            for tick in 0..<100_000 {
+                tracker.record(latency: TimeInterval(tick % 300) / 10)
+            }
+            _ = tracker.labels()
+        }
+    }
+
+}
@@ -0,0 +1,232 @@
+//
+//  LiveEnrichmentLoadTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+/**
+ End-to-end live enrichment through a real EchoClient, BrokerFactory, LiveBroker, Schedule and ESS
+ client, with ESS itself replaced by `EssStandInServer`. Each run's latency percentiles and CPU time are
+ attached to the test result.
+ */
+class LiveEnrichmentLoadTests: XCTestCase {
+
+    let serviceId = "bbc_one_london"
+
+    // ess_sample.json covers 2016-02-12 11:00 to 2016-02-13 06:00
+    let scheduleTime: TimeInterval = 1455290000
+
+    var json: Data!
+
+    struct Report {
+        var sessions = 0
+        var enriched = 0
+        var failedEnrichments = 0
+        var requests = 0
+        var latencies = [TimeInterval]()
+        var cpuTime: TimeInterval = 0
+
+        var summary: String {
+            return "sessions=\(sessions) enriched=\(enriched) failed=\(failedEnrichments) requests=\(requests) " +
+                    "latency p50=\(percentile(0.5))s p95=\(percentile(0.95))s p99=\(percentile(0.99))s cpu=\(cpuTime)s"
+        }
+
+        func percentile(_ fraction: Double) -> TimeInterval {
+            guard !latencies.isEmpty else {
+                return 0
+            }
+            let sorted = latencies.sorted()
+            return sorted[min(sorted.count - 1, Int(Double(sorted.count) * fraction))]
+        }
+    }
+
+    class EnrichmentRecordingDelegate: EchoDelegateMock {
+        let started = Date()
+        var enrichedAt: Date?
+        var enrichmentFailed = false
+        var onFinished: (() -> Void)?
+
+        override func liveMediaUpdate(_ newMedia: Media, newPosition: UInt64, oldPosition: UInt64) {
+            if enrichedAt == nil {
+                enrichedAt = Date()
+                onFinished?()
+            }
+        }
+
+        override func liveEnrichmentFailed() {
+            if !enrichmentFailed && enrichedAt == nil {
+                enrichmentFailed = true
+                onFinished?()
+            }
+        }
+    }
+
+    class SingleDelegateFactory: EchoDelegateFactoryProtocol {
+        let delegate: EchoDelegate
+
+        init(delegate: EchoDelegate) {
+            self.delegate = delegate
+        }
+
+        func getDelegates(_ appName: String, appType: ApplicationType, startCounterName: String,
+                          device: EchoDeviceDelegate, config: [EchoConfigKey: String], bbcUser: BBCUser) -> [EchoDelegate] {
+            return [delegate]
+        }
+    }
+
+    override func setUp() {
+        super.setUp()
+
+        let bundle = Bundle(for: type(of: self))
+        let path = bundle.path(forResource: "ess_sample", ofType: "json")!
+        json = try? Data(contentsOf: URL(fileURLWithPath: path))
+    }
+
+    override func tearDown() {
+        EssStandInServer.stop()
+        super.tearDown()
+    }
+
+    func runSessions(_ count: Int, configuration: EssStandInServer.Configuration, timestamp: TimeInterval,
+                     timeout: TimeInterval = 30, expectCompletion: Bool = true) -> Report {
+        EssStandInServer.start(configuration)
+
+        var config = [EchoConfigKey: String]()
+        config[.useESS] = "true"
+        config[.essURL] = EssStandInServer.host
+        config[.echoDebug] = "false"
+
+        var report = Report()
+        var clients = [EchoClient]()
+        var delegates = [EnrichmentRecordingDelegate]()
+        let cpuBefore = LiveEnrichmentLoadTests.processCPUTime()
+
+        for _ in 0..<count {
+            let delegate = EnrichmentRecordingDelegate()
+            if expectCompletion {
+                let finished = expectation(description: "enrichment finished")
+                delegate.onFinished = { finished.fulfill() }
+            }
+
+            guard let client = try? EchoClient(appName: "load_test", appType: .mobileApp, startCounterName: "load.test.page",
+                                               config: config, echoDelegateFactory: SingleDelegateFactory(delegate: delegate),
+                                               device: EchoDevice(), brokerFactory: BrokerFactory(), bbcUser: BBCUser()) else {
+                XCTFail("Failed to initialise echo client")
+                return report
+            }
+
+            let playerDelegate = PlayerDelegateMock()
+            playerDelegate.timestamp = timestamp
+            playerDelegate.position = 0
+
+            let media = Media(avType: .video, consumptionMode: .live)
+            media.serviceID = serviceId
+
+            client.setPlayerName("load_test_player")
+            client.setPlayerVersion("1.0")
+            client.setPlayerDelegate(playerDelegate)
+            client.setMedia(media)
+            client.avPlayEvent(at: 0, eventLabels: nil)
+
+            clients.append(client)
+            delegates.append(delegate)
+        }
+
+        if expectCompletion {
+            waitForExpectations(timeout: timeout, handler: nil)
+        } else {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: timeout))
+        }
+
+        report.cpuTime = LiveEnrichmentLoadTests.processCPUTime() - cpuBefore
+        report.sessions = count
+        report.requests = EssStandInServer.requestCount
+
+        for delegate in delegates {
+            if let enrichedAt = delegate.enrichedAt {
+                report.enriched += 1
+                report.latencies.append(enrichedAt.timeIntervalSince(delegate.started))
+            } else if delegate.enrichmentFailed {
+                report.failedEnrichments += 1
+            }
+        }
+
+        for client in clients {
+            client.avEndEvent(at: 0, eventLabels: nil)
+        }
+
+        let attachment = XCTAttachment(string: report.summary)
+        attachment.name = "Live enrichment load"
+        attachment.lifetime = .keepAlways
+        add(attachment)
+        return report
+    }
+
+    static func processCPUTime() -> TimeInterval {
+        var usage = rusage()
+        getrusage(RUSAGE_SELF, &usage)
+        let user = TimeInterval(usage.ru_utime.tv_sec) + TimeInterval(usage.ru_utime.tv_usec) / 1_000_000
+        let system = TimeInterval(usage.ru_stime.tv_sec) + TimeInterval(usage.ru_stime.tv_usec) / 1_000_000
+        return user + system
+    }
+
+    func testSingleSessionIsEnrichedFromStandIn() {
+        let report = runSessions(1, configuration: EssStandInServer.Configuration(schedule: .recorded(json)),
+                                 timestamp: scheduleTime)
+
+        XCTAssertEqual(1, report.enriched)
+        XCTAssertEqual(1, report.requests)
+    }
+
+    func testSessionsAreEnrichedWithLatency() {
+        var configuration = EssStandInServer.Configuration(schedule: .recorded(json))
+        configuration.latency = 0.2
+
+        let report = runSessions(10, configuration: configuration, timestamp: scheduleTime)
+
+        XCTAssertEqual(10, report.enriched)
+        XCTAssertGreaterThanOrEqual(report.percentile(0.5), 0.2)
+    }
+
+    func testFailingEssReportsEnrichmentFailure() {
+        var configuration = EssStandInServer.Configuration(schedule: .recorded(json))
+        configuration.failureRate = 1
+
+        let report = runSessions(5, configuration: configuration, timestamp: scheduleTime)
+
+        XCTAssertEqual(0, report.enriched)
+        XCTAssertEqual(5, report.failedEnrichments)
+    }
+
+    func testSessionOutsideScheduleBoundaryIsNotEnriched() {
+        let configuration = EssStandInServer.Configuration(schedule: .generated(serviceId: serviceId,
+                start: scheduleTime - 3600, end: scheduleTime, slotLength: 900))
+
+        let report = runSessions(1, configuration: configuration, timestamp: scheduleTime + 60,
+                                 timeout: 2, expectCompletion: false)
+
+        XCTAssertEqual(0, report.enriched)
+    }
+
+    func testLoadOfManyLiveSessions() {
+        var configuration = EssStandInServer.Configuration(schedule: .generated(serviceId: serviceId,
+                start: scheduleTime - 86400, end: scheduleTime + 86400, slotLength: 1800))
+        configuration.latency = 0.05
+        configuration.failureRate = 0.05
+        configuration.seed = 2026
+
+        let report = runSessions(200, configuration: configuration, timestamp: scheduleTime)
+
+        XCTAssertEqual(200, report.enriched + report.failedEnrichments)
+        XCTAssertGreaterThanOrEqual(report.requests, 200)
+        XCTAssertGreaterThanOrEqual(report.percentile(0.5), 0.05)
+        XCTAssertLessThan(report.percentile(0.95), 30)
+        XCTAssertGreaterThan(report.cpuTime, 0)
+    }
+
+}
@@ -0,0 +1,219 @@
+//
+//  PersistentLabelSnapshotTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class PersistentLabelSnapshotTests: XCTestCase {
+
+    var directory: URL!
+
+    let persistent = ["bbc_site": "news", "app_name": "news", "app_type": "mobile-app", "app_version": "5.12.0",
+                      "bbc_hid": "a8f5f167f44f4964e6c998dee827110c", "ml_name": "echo_ios_swift", "ml_version": "5.2.1",
+                      "device_id": "2f1ab0e5-5c2f-4b43-9b7e-0a2b5c7e4d21", "screen_orientation": "portrait",
+                      "is_signed_in": "true", "destination": "NEWS_GNL", "producer": "NEWS"]
+
+    class LabelRecordingDelegate: EchoDelegateMock {
+        var labels = [String: String]()
+        var labelsAtEvent = [String: [String: String]]()
+
+        override func addLabels(_ labels: [String: String]) {
+            self.labels.merge(labels) { _, new in new }
+        }
+
+        override func removeLabels(_ labels: [String]) {
+            for key in labels {
+                self.labels.removeValue(forKey: key)
+            }
+        }
+
+        override func viewEvent(counterName: String, eventLabels: [String: String]?) {
+            labelsAtEvent[counterName] = labels
+        }
+    }
+
+    override func setUp() {
+        super.setUp()
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent("PersistentLabelSnapshotTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() {
+        CollectorStandInServer.stop()
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func size(of directory: URL) -> Int {
+        let files = (try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil, options: [])) ?? []
+        return files.reduce(0) { $0 + ((try? Data(contentsOf: $1))?.count ?? 0) }
+    }
+
+    func testVersionOnlyChangesWhenLabelsDo() {
+        let snapshot = PersistentLabelSnapshot()
+        XCTAssertEqual(0, snapshot.version)
+
+        snapshot.add(["a": "1"])
+        snapshot.add(["a": "1"])
+        XCTAssertEqual(1, snapshot.version)
+
+        snapshot.remove(["missing"])
+        XCTAssertEqual(1, snapshot.version)
+
+        snapshot.remove(["a"])
+        XCTAssertEqual(2, snapshot.version)
+        XCTAssertTrue(snapshot.labels.isEmpty)
+    }
+
+    func testSnapshotIsLoggedOnceAndEventsReferToIt() throws {
+        let log = try EchoEventLog(directory: directory)
+        let snapshot = PersistentLabelSnapshot()
+        snapshot.add(persistent)
+
+        for index in 1...5 {
+            log.append(EchoEventRecord(kind: .view, name: "page.\(index)", labels: nil), snapshot: snapshot)
+        }
+
+        var snapshots = 0
+        var versions = Set<UInt32>()
+        log.forEachRecord(after: 0, includeSnapshots: true) { _, record in
+            if record.kind == .labelSnapshot {
+                snapshots += 1
+            } else {
+                versions.insert(record.snapshotVersion)
+            }
+        }
+
+        XCTAssertEqual(1, snapshots)
+        XCTAssertEqual([1], versions)
+    }
+
+    func testReplayAppliesTheLabelsEachEventWasLoggedWith() throws {
+        let log = try EchoEventLog(directory: directory, segmentSize: 256)
+        let snapshot = PersistentLabelSnapshot()
+
+        snapshot.add(["site": "news", "signed_in": "false"])
+        log.append(EchoEventRecord(kind: .view, name: "first", labels: nil), snapshot: snapshot)
+        snapshot.add(["signed_in": "true"])
+        snapshot.remove(["site"])
+        for index in 0..<10 {
+            log.append(EchoEventRecord(kind: .view, name: "later.\(index)", labels: nil), snapshot: snapshot)
+        }
+
+        let delegate = LabelRecordingDelegate()
+        log.replayUndelivered(to: [delegate])
+
+        XCTAssertEqual(["site": "news", "signed_in": "false"], delegate.labelsAtEvent["first"]!)
+        XCTAssertEqual(["signed_in": "true"], delegate.labelsAtEvent["later.9"]!)
+    }
+
+    func testReplayAfterDeliveredSegmentsAreRemovedStillHasLabels() throws {
+        let log = try EchoEventLog(directory: directory, segmentSize: 256)
+        let snapshot = PersistentLabelSnapshot()
+        snapshot.add(["site": "news"])
+
+        for index in 0..<40 {
+            log.append(EchoEventRecord(kind: .view, name: "page.\(index)", labels: nil), snapshot: snapshot)
+        }
+        log.markDelivered(through: log.lastSequence - 1)
+        log.checkpoint()
+
+        let delegate = LabelRecordingDelegate()
+        log.replayUndelivered(to: [delegate])
+
+        XCTAssertEqual(["site": "news"], delegate.labelsAtEvent["page.39"]!)
+    }
+
+    func testCollectorBatchesExpandToFullLabels() {
+        CollectorStandInServer.start()
+        let delegate = EchoCollectorDelegate(appName: "news", collectorURL: CollectorStandInServer.url)
+        delegate.start()
+        delegate.addLabels(persistent)
+
+        delegate.viewEvent(counterName: "first", eventLabels: ["bbc_site": "sport"])
+        delegate.removeLabel("is_signed_in")
+        delegate.viewEvent(counterName: "second", eventLabels: nil)
+        delegate.flushCache()
+
+        let deadline = Date(timeIntervalSinceNow: 10)
+        while CollectorStandInServer.received.isEmpty && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+
+        let events = CollectorStandInServer.received.first?.events ?? []
+        let first = events.first?["labels"] as? [String: String]
+        let second = events.last?["labels"] as? [String: String]
+        XCTAssertEqual("sport", first?["bbc_site"])
+        XCTAssertEqual("true", first?["is_signed_in"])
+        XCTAssertEqual("news", second?["bbc_site"])
+        XCTAssertNil(second?["is_signed_in"])
+    }
+
+    // MARK: - Bytes per session
+
+    func testDiskBytesPerSession() throws {
+        let snapshot = PersistentLabelSnapshot()
+        snapshot.add(persistent)
+
+        let deltaLog = try EchoEventLog(directory: directory.appendingPathComponent("delta"))
+        let fullLog = try EchoEventLog(directory: directory.appendingPathComponent("full"))
+
+        for index in 0..<200 {
+            let labels = ["event_index": String(index)]
+            deltaLog.append(EchoEventRecord(kind: .view, name: "news.page", labels: labels), snapshot: snapshot)
+            fullLog.append(EchoEventRecord(kind: .view, name: "news.page", labels: labels.merging(persistent) { new, _ in new }))
+        }
+        deltaLog.checkpoint()
+        fullLog.checkpoint()
+
+        let deltaBytes = size(of: directory.appendingPathComponent("delta"))
+        let fullBytes = size(of: directory.appendingPathComponent("full"))
+
+        attach("Event log for 200 events: full labels \(fullBytes) bytes, snapshot deltas \(deltaBytes) bytes")
+        XCTAssertGreaterThan(deltaBytes, 0)
+        XCTAssertLessThan(deltaBytes, fullBytes / 3)
+    }
+
+    func testNetworkBytesPerSession() {
+        CollectorStandInServer.start()
+        var configuration = EchoCollectorBatcher.Configuration()
+        configuration.maxEvents = 20
+        let delegate = EchoCollectorDelegate(appName: "news", collectorURL: CollectorStandInServer.url, configuration: configuration)
+        delegate.start()
+        delegate.addLabels(persistent)
+
+        for index in 0..<100 {
+            delegate.viewEvent(counterName: "news.story.\(index).page", eventLabels: nil)
+        }
+        delegate.flushCache()
+
+        let deadline = Date(timeIntervalSinceNow: 10)
+        while CollectorStandInServer.received.reduce(0, { $0 + $1.events.count }) < 100 && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+
+        let received = CollectorStandInServer.received
+        let sentBytes = received.reduce(0) { $0 + $1.bytes }
+        let expandedBytes = received.reduce(0) { total, batch in
+            total + ((try? JSONSerialization.data(withJSONObject: ["session": batch.session ?? "", "batch": batch.batch,
+                                                                   "events": batch.events], options: []))?.count ?? 0)
+        }
+
+        attach("Collector bytes for 100 events: full labels \(expandedBytes), snapshot deltas \(sentBytes)")
+        XCTAssertEqual(100, received.reduce(0) { $0 + $1.events.count })
+        XCTAssertLessThan(sentBytes, expandedBytes / 2)
+    }
+
+    func attach(_ summary: String) {
+        let attachment = XCTAttachment(string: summary)
+        attachment.name = name
+        attachment.lifetime = .keepAlways
+        add(attachment)
+    }
+
+}
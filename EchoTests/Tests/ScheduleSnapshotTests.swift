@@ -0,0 +1,153 @@
+//
+//  ScheduleSnapshotTests.swift
+//  EchoTests
+//
+//  Copyright © 2026 BBC. All rights reserved.
+//
+
+import Foundation
+import XCTest
+@testable import Echo
+
+class ScheduleSnapshotTests: XCTestCase {
+
+    var json: Data!
+    var snapshot: ScheduleSnapshot!
+    var directory: URL!
+
+    override func setUp() {
+        super.setUp()
+
+        let bundle = Bundle(for: type(of: self))
+        let path = bundle.path(forResource: "ess_sample", ofType: "json")!
+        json = try? Data(contentsOf: URL(fileURLWithPath: path))
+
+        snapshot = ScheduleSnapshot(data: ScheduleSnapshot.encode(essResponse: json)!)
+
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent("ScheduleSnapshotTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    func testSnapshotQueryReturnsCorrectBroadcast() {
+        let broadcast = snapshot.query(1455290000)!
+        XCTAssertEqual("b038nzy4", broadcast.versionId)
+        XCTAssertEqual("p03h5grk", broadcast.id)
+        XCTAssertEqual("b038nzyd", broadcast.episodeId)
+        XCTAssertEqual("Escape to the Country", broadcast.brandTitle)
+    }
+
+    func testSnapshotQueryReturnsNilOptionalIfNoBroadcastAtTime() {
+        XCTAssertNil(snapshot.query(12345))
+    }
+
+    func testSnapshotQueryIsExclusiveOfBroadcastEndTime() {
+        // b038nzy4 ends at 15:45, which is when the next broadcast starts
+        let broadcast = snapshot.query(1455291900)!
+        XCTAssertNotEqual("b038nzy4", broadcast.versionId)
+    }
+
+    func testSnapshotSetsServiceIdFromResponse() {
+        XCTAssertEqual("bbc_one_london", snapshot.getServiceID())
+        XCTAssertTrue(snapshot.hasData())
+        XCTAssertNil(snapshot.getError())
+    }
+
+    func testSnapshotRoundTripMatchesJsonSchedule() {
+        let schedule = Schedule(httpClient: HttpClientMock())
+        schedule.fetchDataFromEss()
+        schedule.didReceiveData(json)
+
+        XCTAssertEqual(34, snapshot.count)
+
+        for index in 0..<snapshot.count {
+            let fromSnapshot = snapshot.broadcast(at: index)
+            let midpoint = (fromSnapshot.startTime + fromSnapshot.endTime) / 2
+            let fromJson = schedule.query(midpoint)!
+
+            XCTAssertEqual(fromJson.startTime, fromSnapshot.startTime)
+            XCTAssertEqual(fromJson.endTime, fromSnapshot.endTime)
+            XCTAssertEqual(fromJson.id, fromSnapshot.id)
+            XCTAssertEqual(fromJson.versionId, fromSnapshot.versionId)
+            XCTAssertEqual(fromJson.episodeId, fromSnapshot.episodeId)
+            XCTAssertEqual(fromJson.episodeTitle, fromSnapshot.episodeTitle)
+            XCTAssertEqual(fromJson.brandTitle, fromSnapshot.brandTitle)
+        }
+    }
+
+    func testEncodingIsStableAcrossRoundTrips() {
+        var broadcasts = [Broadcast]()
+        for index in 0..<snapshot.count {
+            broadcasts.append(snapshot.broadcast(at: index))
+        }
+
+        let reencoded = ScheduleSnapshot.encode(serviceID: snapshot.getServiceID(), broadcasts: broadcasts)
+        XCTAssertEqual(ScheduleSnapshot.encode(essResponse: json), reencoded)
+    }
+
+    func testRepeatedBrandTitlesAreStoredOnce() {
+        let pool = BroadcastStringPool()
+        let broadcasts = (0..<100).map { index in
+            Broadcast(startTime: TimeInterval(index * 60), endTime: TimeInterval(index * 60 + 60), episodeId: "ep\(index)",
+                      episodeTitle: "News", id: "id\(index)", versionId: "v\(index)", brandTitle: "BBC News", pool: pool)
+        }
+
+        let single = ScheduleSnapshot.encode(serviceID: "bbc_news24", broadcasts: Array(broadcasts.prefix(1)))
+        let all = ScheduleSnapshot.encode(serviceID: "bbc_news24", broadcasts: broadcasts)
+        let perRecordGrowth = (all.count - single.count) / 99
+
+        // Fixed width record plus three short unique ids, the titles add nothing
+        XCTAssertLessThan(perRecordGrowth, ScheduleSnapshot.recordSize + 3 * (4 + 5))
+    }
+
+    func testInvalidDataIsRejected() {
+        XCTAssertNil(ScheduleSnapshot(data: Data()))
+        XCTAssertNil(ScheduleSnapshot(data: "blahblahblah".data(using: .utf8)!))
+
+        var truncated = ScheduleSnapshot.encode(essResponse: json)!
+        truncated.removeLast(10)
+        XCTAssertNil(ScheduleSnapshot(data: truncated))
+    }
+
+    func testInvalidJsonIsNotEncoded() {
+        XCTAssertNil(ScheduleSnapshot.encode(essResponse: "blahblahblah".data(using: .utf8)!))
+    }
+
+    func testSnapshotIsMappedFromAFile() throws {
+        let url = directory.appendingPathComponent("bbc_one_london.ess")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true, attributes: nil)
+        try ScheduleSnapshot.encode(essResponse: json)!.write(to: url)
+
+        let mapped = ScheduleSnapshot(contentsOf: url)
+
+        XCTAssertEqual("b038nzy4", mapped?.query(1455290000)?.versionId)
+        XCTAssertNil(ScheduleSnapshot(contentsOf: directory.appendingPathComponent("missing.ess")))
+    }
+
+    func testPerformanceOfSnapshotLoadAndQuery() throws {
+        let url = directory.appendingPathComponent("bbc_one_london.ess")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true, attributes: nil)
+        try ScheduleSnapshot.encode(essResponse: json)!.write(to: url)
+
+        measure {
+            for _ in 0..<1000 {
+                _ = ScheduleSnapshot(contentsOf: url)?.query(1455290000)
+            }
+        }
+    }
+
+    func testPerformanceOfJsonParseAndQuery() {
+        measure {
+            for _ in 0..<1000 {
+                let schedule = Schedule(httpClient: HttpClientMock())
+                schedule.didReceiveData(json)
+                _ = schedule.query(1455290000)
+            }
+        }
+    }
+
+}